@@ -0,0 +1,96 @@
+/***********************************************************************
+ * Header:
+ *    Aligned Array
+ * Summary:
+ *    A custom::array whose storage starts and ends on an alignment
+ *    boundary, usually a cache line or a vector register
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       aligned_array  : an array aligned and padded to Align bytes
+ *       assume_aligned : tell the compiler a pointer is aligned
+ *
+ *    Because the size is padded to a multiple of Align, two
+ *    aligned_arrays never share a cache line (no false sharing)
+ *    and the first element is always on an Align boundary.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uintptr_t
+#include <memory>     // for std::assume_aligned
+#include "array.h"
+
+namespace custom
+{
+
+// The size of a cache line on the machines we target
+const size_t cache_line_size = 64;
+
+/*****************************************************
+ * ASSUME ALIGNED
+ * Promise the compiler that p is on an Align boundary
+ * so it can use aligned vector loads and stores.
+ ****************************************************/
+template <size_t Align, typename T>
+inline T * assume_aligned(T * p)
+{
+#if defined(__cpp_lib_assume_aligned)
+   return std::assume_aligned<Align>(p);
+#elif defined(__GNUC__)
+   return static_cast<T *>(__builtin_assume_aligned(p, Align));
+#else
+   return p;
+#endif
+}
+
+/************************************************
+ * ALIGNED ARRAY
+ * An array whose storage is aligned and padded to
+ * Align bytes. Everything else is custom::array.
+ ***********************************************/
+template <typename T, int N, size_t Align = cache_line_size>
+struct alignas(Align) aligned_array : public array <T, N>
+{
+   static_assert((Align & (Align - 1)) == 0,
+                 "alignment must be a power of two");
+   static_assert(Align >= alignof(T),
+                 "alignment must be at least the alignment of T");
+
+   // The alignment of the first element
+   static const size_t alignment = Align;
+
+   //
+   // Access
+   //
+
+   // Return a pointer to the storage that the compiler knows is aligned
+   T * aligned_data()
+   {
+      return assume_aligned<Align>(this->__elems_);
+   }
+   const T * aligned_data() const
+   {
+      return assume_aligned<Align>(this->__elems_);
+   }
+
+   //
+   // Status
+   //
+
+   // Is the storage where we promised it would be?
+   bool is_aligned() const
+   {
+      return reinterpret_cast<uintptr_t>(this->__elems_) % Align == 0;
+   }
+};
+
+}; // namespace custom
@@ -11,8 +11,16 @@
  *    |_____| |_____|  \______.' /_/
  *    
  *    This will contain the class definition of:
- *       array             : similar to std::array
- *       array :: iterator : an iterator through the array
+ *       array                   : similar to std::array
+ *       array :: iterator       : an iterator through the array
+ *       array :: const_iterator : an iterator through a const array
+ *       swap                    : exchange the contents of two arrays
+ *       ==, !=, <, >, <=, >=    : compare two arrays element by element
+ *       to_array                : an array copied from a built-in array
+ *       make_array              : an array filled by a generator
+ *
+ *    fill, swap and == become memset/memcpy/memcmp when T is made of
+ *    plain bytes; everything else goes one element at a time.
  * Author
  *    Ashlee Hart
  * Sources: 
@@ -22,13 +30,94 @@
 
 #pragma once
 
-#include <stdexcept>
+#include <cstddef>      // for std::ptrdiff_t
+#include <cstring>      // for memcpy, memset and memcmp
+#include <iterator>     // for std::reverse_iterator
+#include <stdexcept>    // for std::out_of_range
+#include <type_traits>  // for std::enable_if and std::is_trivially_copyable
+#include <utility>      // for std::move
 
 class TestArray; // forward declaration for unit tests
 
 namespace custom
 {
 
+/*****************************************************
+ * IS CONSTANT EVALUATED
+ * Is the compiler running this? memcpy and friends
+ * are not allowed there, so the fast paths step aside.
+ ****************************************************/
+constexpr bool isConstantEvaluated()
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+   return std::is_constant_evaluated();
+#elif defined(__GNUC__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+   return __builtin_is_constant_evaluated();
+#else
+   return true;  // no way to tell, so always take the portable path
+#endif
+}
+
+/*****************************************************
+ * IS BITWISE COMPARABLE
+ * Are two T's equal exactly when their bytes are?
+ * True for integers, enums and pointers. Not for
+ * floating point (0.0 == -0.0) or for classes, which
+ * may have padding or their own idea of equality.
+ ****************************************************/
+template <typename T>
+struct isBitwiseComparable : std::integral_constant<bool,
+   std::is_integral<T>::value || std::is_enum<T>::value ||
+   std::is_pointer<T>::value>
+{
+};
+
+/*****************************************************
+ * IS BYTE ORDERED
+ * Does memcmp put T's in the same order as < does?
+ * Only for unsigned one-byte integers.
+ ****************************************************/
+template <typename T>
+struct isByteOrdered : std::integral_constant<bool,
+   sizeof(T) == 1 && std::is_integral<T>::value && std::is_unsigned<T>::value>
+{
+};
+
+/*****************************************************
+ * NEXT POWER OF TWO
+ * The smallest power of two at least n. Tables sized
+ * this way can use index & (size - 1) for index % size.
+ ****************************************************/
+constexpr int next_power_of_two(int n)
+{
+   int size = 1;
+   while (size < n)
+      size *= 2;
+   return size;
+}
+
+/*****************************************************
+ * SWAP BYTES
+ * Exchange numBytes bytes between two buffers that
+ * do not overlap, a chunk at a time through the stack
+ ****************************************************/
+inline void swapBytes(void * pLHS, void * pRHS, size_t numBytes)
+{
+   unsigned char * lhs = static_cast<unsigned char *>(pLHS);
+   unsigned char * rhs = static_cast<unsigned char *>(pRHS);
+   unsigned char temp[256];
+   while (numBytes)
+   {
+      size_t chunk = numBytes < sizeof(temp) ? numBytes : sizeof(temp);
+      memcpy(temp, lhs, chunk);
+      memcpy(lhs,  rhs, chunk);
+      memcpy(rhs, temp, chunk);
+      lhs += chunk;
+      rhs += chunk;
+      numBytes -= chunk;
+   }
+}
+
 /************************************************
  * ARRAY
  * A class that holds stuff
@@ -49,24 +138,124 @@ public:
 
    // No assignment operators needed here
 
+   // Fill
+   // Assign value to every element in the array. Plain bytes are
+   // copied with memset, or with memcpy doubling the filled part.
+   constexpr void fill(const T & value)
+   {
+      if constexpr (std::is_trivially_copyable<T>::value)
+         if (!isConstantEvaluated())
+         {
+            __elems_[0] = value;
+            if constexpr (sizeof(T) == 1)
+            {
+               unsigned char byte = 0;
+               memcpy(&byte, __elems_, 1);
+               memset(__elems_, byte, N);
+            }
+            else
+               for (size_t done = 1; done < (size_t)N; done *= 2)
+                  memcpy(__elems_ + done, __elems_,
+                         (done < N - done ? done : N - done) * sizeof(T));
+            return;
+         }
+
+      for (int i = 0; i < N; i++)
+         __elems_[i] = value;
+   }
+
+   // Swap
+   // Exchange the elements of this array with those of rhs. Plain
+   // bytes are swapped with memcpy, everything else is moved. An
+   // array swapped with itself is left alone: memcpy must not be
+   // handed the same buffer twice.
+   constexpr void swap(array & rhs)
+   {
+      if (this == &rhs)
+         return;
+
+      if constexpr (std::is_trivially_copyable<T>::value)
+         if (!isConstantEvaluated())
+         {
+            swapBytes(__elems_, rhs.__elems_, sizeof(__elems_));
+            return;
+         }
+
+      for (int i = 0; i < N; i++)
+      {
+         T temp(std::move(__elems_[i]));
+         __elems_[i] = std::move(rhs.__elems_[i]);
+         rhs.__elems_[i] = std::move(temp);
+      }
+   }
+
    //
    // Iterator
    //
 
    // Forward declaration for the iterator class
-   class iterator;
+   template <typename U>
+   class basic_iterator;
+   typedef basic_iterator <T>                    iterator;
+   typedef basic_iterator <const T>              const_iterator;
+   typedef std::reverse_iterator<iterator>       reverse_iterator;
+   typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
    // Begin and end methods
    // Return an iterator referring to the first element in the array
-   iterator begin() 
+   constexpr iterator begin() 
    { 
       return iterator(__elems_);
    }
+   constexpr const_iterator begin() const
+   {
+      return const_iterator(__elems_);
+   }
+   constexpr const_iterator cbegin() const
+   {
+      return const_iterator(__elems_);
+   }
    // Return an iterator referring to the first element off the end of the array
-   iterator end()   
+   constexpr iterator end()   
    { 
       return iterator(__elems_ + N); 
    }
+   constexpr const_iterator end() const
+   {
+      return const_iterator(__elems_ + N);
+   }
+   constexpr const_iterator cend() const
+   {
+      return const_iterator(__elems_ + N);
+   }
+
+   // Reverse begin and end methods
+   // Return an iterator referring to the last element in the array
+   constexpr reverse_iterator rbegin()
+   {
+      return reverse_iterator(end());
+   }
+   constexpr const_reverse_iterator rbegin() const
+   {
+      return const_reverse_iterator(end());
+   }
+   constexpr const_reverse_iterator crbegin() const
+   {
+      return const_reverse_iterator(end());
+   }
+   // Return an iterator referring to the element before the first
+   constexpr reverse_iterator rend()
+   {
+      return reverse_iterator(begin());
+   }
+   constexpr const_reverse_iterator rend() const
+   {
+      return const_reverse_iterator(begin());
+   }
+   constexpr const_reverse_iterator crend() const
+   {
+      return const_reverse_iterator(begin());
+   }
 
    // 
    // Access
@@ -74,26 +263,26 @@ public:
 
    // Subscript
    // Return the i-th element in the array
-   T& operator [] (size_t index)       
+   constexpr T& operator [] (size_t index)       
    { 
       return __elems_[index]; 
    }
 
    // Return the i-th element in the array
-   const T& operator [] (size_t index) const 
+   constexpr const T& operator [] (size_t index) const 
    { 
       return __elems_[index];
    }
 
    // At
-   T& at(size_t index)  
+   constexpr T& at(size_t index)  
    {
       if (index >= N) {
          throw std::out_of_range("Index out of range.");
       }
       return __elems_[index];
    }
-   const T& at(size_t index) const 
+   constexpr const T& at(size_t index) const 
    {
       if (index >= N) {
          throw std::out_of_range("Index out of range.");
@@ -103,26 +292,37 @@ public:
 
    // Front and Back
    // Return the first element in the array
-   T& front()       
+   constexpr T& front()       
    { 
       return __elems_[0]; 
    }
    // Return the last element in the array
-   T& back()        
+   constexpr T& back()        
    { 
       return __elems_[N - 1]; 
    }
    // Return the first element in the array
-   const T& front() const 
+   constexpr const T& front() const 
    { 
       return __elems_[0]; 
    }
    // Return the last element in the array
-   const T& back()  const 
+   constexpr const T& back()  const 
    { 
       return __elems_[N -1]; 
    }
 
+   // Data
+   // Return a pointer to the underlying storage
+   constexpr T* data()
+   {
+      return __elems_;
+   }
+   constexpr const T* data() const
+   {
+      return __elems_;
+   }
+
    //
    // Remove
 
@@ -133,11 +333,11 @@ public:
    //
 
    // Number of elements in the array
-   size_t size()  const 
+   constexpr size_t size()  const 
    { 
       return N;           
    }
-   bool empty() const 
+   constexpr bool empty() const 
    { 
       return N == 0;
    }
@@ -154,32 +354,52 @@ public:
 
 /**************************************************
  * ARRAY ITERATOR
- * An iterator through array
+ * A contiguous, random-access iterator through array.
+ * U is T for iterator and const T for const_iterator.
  *************************************************/
 template <typename T, int N>
-class array <T, N> :: iterator
+template <typename U>
+class array <T, N> :: basic_iterator
 {
    friend class ::TestArray; // give unit tests access to the privates
+   template <typename V>
+   friend class basic_iterator;
 public:
+   // Traits so the standard algorithms can use the fast paths
+   typedef std::random_access_iterator_tag iterator_category;
+#ifdef __cpp_lib_concepts
+   typedef std::contiguous_iterator_tag    iterator_concept;
+#endif
+   typedef typename std::remove_const<U>::type value_type;
+   typedef U                               element_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef U *                             pointer;
+   typedef U &                             reference;
+
    // Constructors, destructors, and assignment operator
    // Initialize the iterator
-   iterator() : p(nullptr)
+   constexpr basic_iterator() : p(nullptr)
    { 
      
    }
-   iterator(T * p)  
+   constexpr basic_iterator(U * p) : p(p)
    {
-      this->p = p;
    }
 
    // Copy an iterator
-   iterator(const iterator & rhs) 
+   constexpr basic_iterator(const basic_iterator & rhs) : p(rhs.p)
+   {
+   }
+
+   // Convert an iterator into a const_iterator
+   template <typename V,
+             typename = typename std::enable_if<std::is_convertible<V *, U *>::value>::type>
+   constexpr basic_iterator(const basic_iterator <V> & rhs) : p(rhs.p)
    {
-      p = rhs.p;
    }
 
    // Copy the pointer
-   iterator & operator = (const iterator & rhs)
+   constexpr basic_iterator & operator = (const basic_iterator & rhs)
    {
       if (this != &rhs) {
          p = rhs.p; 
@@ -188,45 +408,228 @@ public:
    }
    
    // Equals, not equals operator
-   bool operator != (const iterator & rhs) const 
+   template <typename V>
+   constexpr bool operator != (const basic_iterator <V> & rhs) const 
    { 
       return p != rhs.p; 
    }
-   bool operator == (const iterator & rhs) const 
+   template <typename V>
+   constexpr bool operator == (const basic_iterator <V> & rhs) const 
    { 
       return p == rhs.p;
    }
+
+   // Relative order of two iterators into the same array
+   template <typename V>
+   constexpr bool operator < (const basic_iterator <V> & rhs) const
+   {
+      return p < rhs.p;
+   }
+   template <typename V>
+   constexpr bool operator > (const basic_iterator <V> & rhs) const
+   {
+      return p > rhs.p;
+   }
+   template <typename V>
+   constexpr bool operator <= (const basic_iterator <V> & rhs) const
+   {
+      return p <= rhs.p;
+   }
+   template <typename V>
+   constexpr bool operator >= (const basic_iterator <V> & rhs) const
+   {
+      return p >= rhs.p;
+   }
    
    // Dereference operator
    // Fetch the element referred to by p
-   T & operator * ()       
+   constexpr U & operator * () const
    { 
       return *p; 
    }
-   const T & operator * () const 
-   { 
-      return *p; 
+   constexpr U * operator -> () const
+   {
+      return p;
+   }
+
+   // Subscript
+   // Fetch the element index places after p
+   constexpr U & operator [] (difference_type index) const
+   {
+      return p[index];
    }
    
    // Prefix increment
-   iterator & operator ++ ()
+   constexpr basic_iterator & operator ++ ()
    {
       ++p;
       return *this;
    }
    
    // Postfix increment
-   iterator operator ++ (int postfix)
+   constexpr basic_iterator operator ++ (int postfix)
    {
-      iterator temp = *this;
+      basic_iterator temp = *this;
       ++p;
       return temp;
    }
+
+   // Prefix decrement
+   constexpr basic_iterator & operator -- ()
+   {
+      --p;
+      return *this;
+   }
+
+   // Postfix decrement
+   constexpr basic_iterator operator -- (int postfix)
+   {
+      basic_iterator temp = *this;
+      --p;
+      return temp;
+   }
+
+   // Move several elements at once
+   constexpr basic_iterator & operator += (difference_type offset)
+   {
+      p += offset;
+      return *this;
+   }
+   constexpr basic_iterator & operator -= (difference_type offset)
+   {
+      p -= offset;
+      return *this;
+   }
+   constexpr basic_iterator operator + (difference_type offset) const
+   {
+      return basic_iterator(p + offset);
+   }
+   constexpr basic_iterator operator - (difference_type offset) const
+   {
+      return basic_iterator(p - offset);
+   }
+   friend constexpr basic_iterator operator + (difference_type offset,
+                                               const basic_iterator & rhs)
+   {
+      return basic_iterator(rhs.p + offset);
+   }
+
+   // Number of elements between two iterators
+   template <typename V>
+   constexpr difference_type operator - (const basic_iterator <V> & rhs) const
+   {
+      return p - rhs.p;
+   }
    
 private:
-   T * p;
+   U * p;
 };
 
+/*****************************************************
+ * SWAP
+ * Exchange the contents of two arrays
+ ****************************************************/
+template <typename T, int N>
+constexpr void swap(array <T, N> & lhs, array <T, N> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+/*****************************************************
+ * ARRAY EQUALS, NOT EQUALS
+ * Are the elements the same? Integers, enums and
+ * pointers are compared with memcmp; everything
+ * else with T's ==, stopping at the first difference.
+ ****************************************************/
+template <typename T, int N>
+constexpr bool operator == (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   if constexpr (isBitwiseComparable<T>::value)
+      if (!isConstantEvaluated())
+         return memcmp(lhs.__elems_, rhs.__elems_, sizeof(lhs.__elems_)) == 0;
+
+   for (int i = 0; i < N; i++)
+      if (!(lhs.__elems_[i] == rhs.__elems_[i]))
+         return false;
+   return true;
+}
+
+template <typename T, int N>
+constexpr bool operator != (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   return !(lhs == rhs);
+}
+
+/*****************************************************
+ * ARRAY LESS THAN
+ * Lexicographic order using only T's <, like
+ * std::lexicographical_compare. Unsigned bytes are
+ * compared with memcmp.
+ ****************************************************/
+template <typename T, int N>
+constexpr bool operator < (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   if constexpr (isByteOrdered<T>::value)
+      if (!isConstantEvaluated())
+         return memcmp(lhs.__elems_, rhs.__elems_, N) < 0;
+
+   for (int i = 0; i < N; i++)
+   {
+      if (lhs.__elems_[i] < rhs.__elems_[i])
+         return true;
+      if (rhs.__elems_[i] < lhs.__elems_[i])
+         return false;
+   }
+   return false;
+}
+
+template <typename T, int N>
+constexpr bool operator > (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   return rhs < lhs;
+}
+
+template <typename T, int N>
+constexpr bool operator <= (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   return !(rhs < lhs);
+}
 
+template <typename T, int N>
+constexpr bool operator >= (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   return !(lhs < rhs);
+}
+
+/*****************************************************
+ * TO ARRAY
+ * Create an array from a built-in array:
+ *    constexpr auto a = custom::to_array({ 1, 2, 3 });
+ ****************************************************/
+template <typename T, int N>
+constexpr array <T, N> to_array(const T (&elements)[N])
+{
+   array <T, N> a{};
+   for (int i = 0; i < N; i++)
+      a[i] = elements[i];
+   return a;
+}
+
+/*****************************************************
+ * MAKE ARRAY
+ * Create an array where element i is generator(i).
+ * With a constexpr generator the whole table is built
+ * by the compiler:
+ *    constexpr auto squares =
+ *       custom::make_array<int, 16>([](int i) { return i * i; });
+ ****************************************************/
+template <typename T, int N, typename Generator>
+constexpr array <T, N> make_array(Generator generator)
+{
+   array <T, N> a{};
+   for (int i = 0; i < N; i++)
+      a[i] = generator(i);
+   return a;
+}
 
 }; // namespace custom
@@ -0,0 +1,430 @@
+/***********************************************************************
+ * Header:
+ *    Bitset
+ * Summary:
+ *    Our custom implementation of std::bitset, packed into an array
+ *    of 64-bit words
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       bitset              : N flags, 64 to a word
+ *       bitset :: reference : a proxy for one bit
+ *
+ *    Counting uses the popcount instruction, searching uses
+ *    count-trailing-zeros, and the bulk and/or/xor go through the
+ *    simd kernels one vector of words at a time.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <stdexcept>    // for std::out_of_range
+#include "array.h"
+#include "simd.h"       // for simd::bit_and, bit_or and bit_xor
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // for __popcnt64 and _BitScanForward64
+#endif
+
+class TestBitset; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************
+ * POPCOUNT
+ * The number of set bits in a word
+ ****************************************************/
+inline int popcount(unsigned long long word)
+{
+#if defined(__GNUC__)
+   return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+   return (int)__popcnt64(word);
+#else
+   int count = 0;
+   for (; word; word &= word - 1)
+      count++;
+   return count;
+#endif
+}
+
+/*****************************************************
+ * COUNT TRAILING ZEROS
+ * The index of the lowest set bit. word may not be 0.
+ ****************************************************/
+inline int countTrailingZeros(unsigned long long word)
+{
+#if defined(__GNUC__)
+   return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+   unsigned long index;
+   _BitScanForward64(&index, word);
+   return (int)index;
+#else
+   int index = 0;
+   for (; !(word & 1); word >>= 1)
+      index++;
+   return index;
+#endif
+}
+
+/************************************************
+ * BITSET
+ * A fixed number of flags, one bit each
+ ***********************************************/
+template <int N>
+class bitset
+{
+   friend class ::TestBitset; // give unit tests access to the privates
+
+   static_assert(N > 0, "bitset needs at least one bit");
+public:
+   typedef unsigned long long word_type;
+   static const int bitsPerWord = 64;
+   static const int numWords    = (N + bitsPerWord - 1) / bitsPerWord;
+
+   class reference;
+
+   //
+   // Construct
+   //
+
+   bitset() : words() { }
+   bitset(unsigned long long value) : words()
+   {
+      words[0] = value;
+      trim();
+   }
+
+   //
+   // Access
+   //
+
+   bool operator [] (size_t pos) const
+   {
+      return (words[pos / bitsPerWord] & bit(pos)) != 0;
+   }
+   reference operator [] (size_t pos)
+   {
+      return reference(&words[pos / bitsPerWord], bit(pos));
+   }
+   bool test(size_t pos) const
+   {
+      check(pos);
+      return (*this)[pos];
+   }
+
+   // The raw words, bit i of the bitset is bit i % 64 of word i / 64
+   const array <word_type, numWords> & data() const { return words; }
+   word_type word(size_t index) const { return words[index]; }
+
+   //
+   // Modify
+   //
+
+   bitset & set();
+   bitset & set(size_t pos, bool value = true);
+   bitset & reset();
+   bitset & reset(size_t pos);
+   bitset & flip();
+   bitset & flip(size_t pos);
+
+   //
+   // Search
+   //
+
+   size_t find_first() const;
+   size_t find_next(size_t pos) const;
+
+   //
+   // Bulk
+   //
+
+   bitset & operator &= (const bitset & rhs)
+   {
+      simd::bit_and(words, rhs.words, words);
+      return *this;
+   }
+   bitset & operator |= (const bitset & rhs)
+   {
+      simd::bit_or(words, rhs.words, words);
+      return *this;
+   }
+   bitset & operator ^= (const bitset & rhs)
+   {
+      simd::bit_xor(words, rhs.words, words);
+      return *this;
+   }
+   bitset operator ~ () const
+   {
+      bitset result(*this);
+      return result.flip();
+   }
+   bool operator == (const bitset & rhs) const
+   {
+      return simd::equal(words, rhs.words);
+   }
+   bool operator != (const bitset & rhs) const
+   {
+      return !(*this == rhs);
+   }
+
+   //
+   // Status
+   //
+
+   size_t count() const;
+   size_t size()  const { return N; }
+   bool   any()   const;
+   bool   none()  const { return !any(); }
+   bool   all()   const { return count() == N; }
+
+private:
+   // the mask for pos within its word
+   static word_type bit(size_t pos)
+   {
+      return 1ULL << (pos % bitsPerWord);
+   }
+
+   // complain about a position off the end
+   static void check(size_t pos)
+   {
+      if (pos >= N)
+         throw std::out_of_range("Bit position out of range.");
+   }
+
+   // clear the unused bits above N in the last word
+   void trim()
+   {
+      if (N % bitsPerWord)
+         words[numWords - 1] &= (1ULL << (N % bitsPerWord)) - 1;
+   }
+
+   array <word_type, numWords> words;  // 64 flags per word
+};
+
+/**************************************************
+ * BITSET REFERENCE
+ * A proxy for one bit, so b[i] = true works
+ *************************************************/
+template <int N>
+class bitset <N> :: reference
+{
+   friend class ::TestBitset; // give unit tests access to the privates
+public:
+   reference(word_type * pWord, word_type mask) : pWord(pWord), mask(mask) { }
+
+   // Read the bit
+   operator bool () const
+   {
+      return (*pWord & mask) != 0;
+   }
+   bool operator ~ () const
+   {
+      return (*pWord & mask) == 0;
+   }
+
+   // Write the bit
+   reference & operator = (bool value)
+   {
+      if (value)
+         *pWord |= mask;
+      else
+         *pWord &= ~mask;
+      return *this;
+   }
+   reference & operator = (const reference & rhs)
+   {
+      return *this = bool(rhs);
+   }
+   reference & flip()
+   {
+      *pWord ^= mask;
+      return *this;
+   }
+
+private:
+   word_type * pWord;  // the word holding the bit
+   word_type mask;     // the bit within the word
+};
+
+/*********************************************
+ * BITSET :: SET
+ * Turn every bit on, one word at a time
+ *    COST   : O(N / 64)
+ *********************************************/
+template <int N>
+bitset <N> & bitset <N> :: set()
+{
+   words.fill(~0ULL);
+   trim();
+   return *this;
+}
+
+/*********************************************
+ * BITSET :: SET
+ * Turn one bit on or off
+ *    COST   : O(1)
+ *********************************************/
+template <int N>
+bitset <N> & bitset <N> :: set(size_t pos, bool value)
+{
+   check(pos);
+   (*this)[pos] = value;
+   return *this;
+}
+
+/*********************************************
+ * BITSET :: RESET
+ * Turn every bit off, one word at a time
+ *    COST   : O(N / 64)
+ *********************************************/
+template <int N>
+bitset <N> & bitset <N> :: reset()
+{
+   words.fill(0ULL);
+   return *this;
+}
+
+/*********************************************
+ * BITSET :: RESET
+ * Turn one bit off
+ *    COST   : O(1)
+ *********************************************/
+template <int N>
+bitset <N> & bitset <N> :: reset(size_t pos)
+{
+   check(pos);
+   words[pos / bitsPerWord] &= ~bit(pos);
+   return *this;
+}
+
+/*********************************************
+ * BITSET :: FLIP
+ * Toggle every bit, one word at a time
+ *    COST   : O(N / 64)
+ *********************************************/
+template <int N>
+bitset <N> & bitset <N> :: flip()
+{
+   for (int i = 0; i < numWords; i++)
+      words[i] = ~words[i];
+   trim();
+   return *this;
+}
+
+/*********************************************
+ * BITSET :: FLIP
+ * Toggle one bit
+ *    COST   : O(1)
+ *********************************************/
+template <int N>
+bitset <N> & bitset <N> :: flip(size_t pos)
+{
+   check(pos);
+   words[pos / bitsPerWord] ^= bit(pos);
+   return *this;
+}
+
+/*********************************************
+ * BITSET :: COUNT
+ * The number of bits that are on
+ *    COST   : O(N / 64)
+ *********************************************/
+template <int N>
+size_t bitset <N> :: count() const
+{
+   size_t total = 0;
+   for (int i = 0; i < numWords; i++)
+      total += popcount(words[i]);
+   return total;
+}
+
+/*********************************************
+ * BITSET :: ANY
+ * Is at least one bit on?
+ *    COST   : O(N / 64)
+ *********************************************/
+template <int N>
+bool bitset <N> :: any() const
+{
+   for (int i = 0; i < numWords; i++)
+      if (words[i])
+         return true;
+   return false;
+}
+
+/*********************************************
+ * BITSET :: FIND FIRST
+ * The position of the lowest bit that is on
+ *    OUTPUT : the position, or N if none are on
+ *    COST   : O(N / 64)
+ *********************************************/
+template <int N>
+size_t bitset <N> :: find_first() const
+{
+   for (int i = 0; i < numWords; i++)
+      if (words[i])
+         return i * bitsPerWord + countTrailingZeros(words[i]);
+   return N;
+}
+
+/*********************************************
+ * BITSET :: FIND NEXT
+ * The position of the lowest bit after pos that is on
+ *    OUTPUT : the position, or N if none are on
+ *    COST   : O(N / 64)
+ *********************************************/
+template <int N>
+size_t bitset <N> :: find_next(size_t pos) const
+{
+   pos++;
+   if (pos >= N)
+      return N;
+
+   // the rest of the word holding pos
+   size_t i = pos / bitsPerWord;
+   word_type word = words[i] & (~0ULL << (pos % bitsPerWord));
+   if (word)
+      return i * bitsPerWord + countTrailingZeros(word);
+
+   // the whole words after it
+   for (i++; i < (size_t)numWords; i++)
+      if (words[i])
+         return i * bitsPerWord + countTrailingZeros(words[i]);
+   return N;
+}
+
+/*********************************************
+ * BITSET AND, OR, XOR
+ * Combine two bitsets into a new one
+ *********************************************/
+template <int N>
+bitset <N> operator & (const bitset <N> & lhs, const bitset <N> & rhs)
+{
+   bitset <N> result(lhs);
+   return result &= rhs;
+}
+
+template <int N>
+bitset <N> operator | (const bitset <N> & lhs, const bitset <N> & rhs)
+{
+   bitset <N> result(lhs);
+   return result |= rhs;
+}
+
+template <int N>
+bitset <N> operator ^ (const bitset <N> & lhs, const bitset <N> & rhs)
+{
+   bitset <N> result(lhs);
+   return result ^= rhs;
+}
+
+}; // namespace custom
@@ -0,0 +1,288 @@
+/***********************************************************************
+ * Header:
+ *    Bloom Filter
+ * Summary:
+ *    A blocked Bloom filter: "definitely not there" or "maybe there"
+ *    for a key, touching exactly one cache line per lookup
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       bloom_block         : 512 bits, one cache line
+ *       bloom_filter        : Blocks blocks held in the object
+ *       mapped_bloom_filter : the blocks of a saved filter, mapped
+ *
+ *    A key's hash picks one block, and then one bit in each of the
+ *    eight 64-bit words of that block, so all eight probes share a
+ *    cache line. Checking them is one AND-NOT of the block against
+ *    a mask with a single test of the result. The bulk calls hash a
+ *    batch of keys and prefetch every block in the batch before
+ *    probing any of them, so the cache misses overlap.
+ *
+ *    A filter is saved with write_mapped_array, so a large deny list
+ *    can be built once and then mapped by every process that needs
+ *    it without being read into memory up front.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint64_t
+#include <functional>      // for std::hash
+#include <stdexcept>       // for std::runtime_error
+#include "array.h"
+#include "alignedArray.h"  // for aligned_array and cache_line_size
+#include "mappedArray.h"   // for mapped_array and write_mapped_array
+#include "search.h"        // for prefetch
+#include "simd.h"          // for simd::bit_or and simd::has_all_bits
+#include "staticMap.h"     // for mix
+
+class TestBloomFilter; // forward declaration for unit tests
+
+namespace custom
+{
+
+// The number of 64-bit words in a block: one cache line
+const int bloom_block_words = (int)(cache_line_size / sizeof(uint64_t));
+
+// One block of the filter; every probe for a key lands in one of these
+typedef array <uint64_t, bloom_block_words> bloom_block;
+
+// The number of keys a bulk call hashes and prefetches before probing
+const size_t bloom_batch_size = 16;
+
+/*****************************************************
+ * BLOOM HASH
+ * Hash the key, then spread the bits: std::hash of
+ * an integer is often the integer itself
+ ****************************************************/
+template <typename Key, typename Hash>
+inline uint64_t bloomHash(const Key & key)
+{
+   return mix((uint64_t)Hash()(key));
+}
+
+/*****************************************************
+ * BLOOM BLOCK
+ * Which of numBlocks blocks the hash falls in: the
+ * high half scaled to [0, numBlocks), no division
+ ****************************************************/
+inline size_t bloomBlock(uint64_t hash, size_t numBlocks)
+{
+   return (size_t)(((hash >> 32) * (uint64_t)numBlocks) >> 32);
+}
+
+/*****************************************************
+ * BLOOM MASK
+ * One bit in each word of the block, six bits of a
+ * second hash per word
+ ****************************************************/
+inline void bloomMask(uint64_t hash, bloom_block & mask)
+{
+   uint64_t bits = mix(hash + 0x9e3779b97f4a7c15ULL);
+   for (int i = 0; i < bloom_block_words; i++)
+      mask[i] = 1ULL << ((bits >> (6 * i)) & 63);
+}
+
+/*****************************************************
+ * BLOOM INSERT
+ * Set the bits of count keys in numBlocks blocks,
+ * a batch at a time
+ ****************************************************/
+template <typename Key, typename Hash>
+void bloomInsert(bloom_block * blocks, size_t numBlocks, const Key * keys, size_t count)
+{
+   uint64_t hashes[bloom_batch_size];
+   size_t   where[bloom_batch_size];
+   for (size_t first = 0; first < count; first += bloom_batch_size)
+   {
+      size_t num = count - first < bloom_batch_size ? count - first : bloom_batch_size;
+      for (size_t i = 0; i < num; i++)
+      {
+         hashes[i] = bloomHash<Key, Hash>(keys[first + i]);
+         where[i]  = bloomBlock(hashes[i], numBlocks);
+         prefetch(blocks + where[i]);
+      }
+      for (size_t i = 0; i < num; i++)
+      {
+         bloom_block mask;
+         bloomMask(hashes[i], mask);
+         simd::bit_or(blocks[where[i]], mask, blocks[where[i]]);
+      }
+   }
+}
+
+/*****************************************************
+ * BLOOM CONTAINS
+ * Test count keys against numBlocks blocks, a batch
+ * at a time. results[i] is false only if keys[i]
+ * was never inserted.
+ ****************************************************/
+template <typename Key, typename Hash>
+size_t bloomContains(const bloom_block * blocks, size_t numBlocks,
+                     const Key * keys, size_t count, bool * results)
+{
+   uint64_t hashes[bloom_batch_size];
+   size_t   where[bloom_batch_size];
+   size_t found = 0;
+   for (size_t first = 0; first < count; first += bloom_batch_size)
+   {
+      size_t num = count - first < bloom_batch_size ? count - first : bloom_batch_size;
+      for (size_t i = 0; i < num; i++)
+      {
+         hashes[i] = bloomHash<Key, Hash>(keys[first + i]);
+         where[i]  = bloomBlock(hashes[i], numBlocks);
+         prefetch(blocks + where[i]);
+      }
+      for (size_t i = 0; i < num; i++)
+      {
+         bloom_block mask;
+         bloomMask(hashes[i], mask);
+         results[first + i] = simd::has_all_bits(blocks[where[i]], mask);
+         found += results[first + i];
+      }
+   }
+   return found;
+}
+
+/************************************************
+ * BLOOM FILTER
+ * A set of Keys that may answer "maybe" for a key
+ * that was never inserted, but never "no" for one
+ * that was. Blocks cache lines of bits.
+ ***********************************************/
+template <typename Key, int Blocks, typename Hash = std::hash<Key> >
+class bloom_filter
+{
+   friend class ::TestBloomFilter; // give unit tests access to the privates
+
+   static_assert(Blocks > 0, "bloom_filter needs at least one block");
+public:
+   //
+   // Construct
+   //
+
+   bloom_filter() : blocks()
+   {
+      clear();
+   }
+
+   //
+   // Insert
+   //
+
+   void insert(const Key & key)
+   {
+      bloomInsert<Key, Hash>(blocks.data(), Blocks, &key, 1);
+   }
+
+   // Insert count keys, overlapping their cache misses
+   void insert(const Key * keys, size_t count)
+   {
+      bloomInsert<Key, Hash>(blocks.data(), Blocks, keys, count);
+   }
+
+   // Forget every key
+   void clear()
+   {
+      for (size_t i = 0; i < (size_t)Blocks; i++)
+         blocks[i].fill(0);
+   }
+
+   //
+   // Query
+   //
+
+   // False means the key was never inserted; true means it may have been
+   bool contains(const Key & key) const
+   {
+      bool result;
+      bloomContains<Key, Hash>(blocks.data(), Blocks, &key, 1, &result);
+      return result;
+   }
+
+   // Test count keys, overlapping their cache misses; returns how many may be there
+   size_t contains(const Key * keys, size_t count, bool * results) const
+   {
+      return bloomContains<Key, Hash>(blocks.data(), Blocks, keys, count, results);
+   }
+
+   //
+   // Save
+   //
+
+   // Write the blocks to a file that mapped_bloom_filter can open
+   void save(const char * path) const
+   {
+      write_mapped_array(path, blocks.data(), (size_t)Blocks, cache_line_size);
+   }
+
+   //
+   // Status
+   //
+
+   size_t block_count() const { return Blocks;                           }
+   size_t bit_count()   const { return Blocks * sizeof(bloom_block) * 8; }
+
+private:
+   aligned_array <bloom_block, Blocks> blocks;  // each block on its own cache line
+};
+
+/************************************************
+ * MAPPED BLOOM FILTER
+ * The blocks of a saved bloom_filter, mapped
+ * read-only. Lookups page in only the blocks they
+ * touch. Key and Hash must match the saved filter.
+ ***********************************************/
+template <typename Key, typename Hash = std::hash<Key> >
+class mapped_bloom_filter
+{
+   friend class ::TestBloomFilter; // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+
+   // Lookups are scattered, so ask the system not to read ahead
+   explicit mapped_bloom_filter(const char * path,
+                                access_advice advice = access_advice::random) :
+      blocks(path, advice)
+   {
+      if (blocks.empty())
+         throw std::runtime_error(std::string(path) + ": no blocks");
+   }
+
+   //
+   // Query
+   //
+
+   bool contains(const Key & key) const
+   {
+      bool result;
+      bloomContains<Key, Hash>(blocks.data(), blocks.size(), &key, 1, &result);
+      return result;
+   }
+
+   size_t contains(const Key * keys, size_t count, bool * results) const
+   {
+      return bloomContains<Key, Hash>(blocks.data(), blocks.size(), keys, count, results);
+   }
+
+   //
+   // Status
+   //
+
+   size_t block_count() const { return blocks.size();                           }
+   size_t bit_count()   const { return blocks.size() * sizeof(bloom_block) * 8; }
+
+private:
+   mapped_array <bloom_block> blocks;
+};
+
+}; // namespace custom
@@ -0,0 +1,156 @@
+/***********************************************************************
+ * Header:
+ *    Fenwick
+ * Summary:
+ *    A binary indexed tree: prefix sums over N counters that can
+ *    change, both in O(log N)
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       fenwick : N values with fast point updates and range sums
+ *
+ *    Slot i holds the sum of the values in (i & (i + 1)) .. i, so
+ *    the whole tree is one custom::array of N sums, the same size
+ *    as the values themselves. Updates and queries walk it with a
+ *    loop of bit tricks, no recursion and no pointers.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <stdexcept>    // for std::out_of_range
+#include "array.h"
+
+class TestFenwick; // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * FENWICK
+ * N values of T, where T can be added and subtracted
+ ***********************************************/
+template <typename T, int N>
+class fenwick
+{
+   friend class ::TestFenwick; // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+
+   // Every value starts at T()
+   fenwick() : tree()
+   {
+      tree.fill(T());
+   }
+
+   // Start from existing values in O(N), not O(N log N)
+   explicit fenwick(const array <T, N> & values);
+
+   //
+   // Modify
+   //
+
+   // Add delta to value index
+   void add(size_t index, const T & delta);
+
+   // Make value index equal to value
+   void set(size_t index, const T & value)
+   {
+      add(index, value - get(index));
+   }
+
+   // Every value back to T()
+   void clear()
+   {
+      tree.fill(T());
+   }
+
+   //
+   // Query
+   //
+
+   // The sum of the first count values, [0, count)
+   T prefix_sum(size_t count) const;
+
+   // The sum of the values in [first, last)
+   T range_sum(size_t first, size_t last) const
+   {
+      return prefix_sum(last) - prefix_sum(first);
+   }
+
+   // The value at index
+   T get(size_t index) const
+   {
+      return range_sum(index, index + 1);
+   }
+
+   //
+   // Status
+   //
+
+   size_t size() const { return N; }
+
+private:
+   array <T, N> tree;  // slot i is the sum of values (i & (i + 1)) .. i
+};
+
+/*********************************************
+ * FENWICK :: CONSTRUCTOR
+ * Each slot passes its sum up to the one slot
+ * above it that also covers it
+ *    INPUT  : the starting values
+ *    COST   : O(N)
+ *********************************************/
+template <typename T, int N>
+fenwick <T, N> :: fenwick(const array <T, N> & values) : tree(values)
+{
+   for (size_t i = 0; i < (size_t)N; i++)
+   {
+      size_t parent = i | (i + 1);
+      if (parent < (size_t)N)
+         tree[parent] = tree[parent] + tree[i];
+   }
+}
+
+/*********************************************
+ * FENWICK :: ADD
+ * Add delta to every slot that covers index
+ *    INPUT  : which value and how much to add
+ *    COST   : O(log N)
+ *********************************************/
+template <typename T, int N>
+void fenwick <T, N> :: add(size_t index, const T & delta)
+{
+   if (index >= (size_t)N)
+      throw std::out_of_range("Index out of range.");
+   for (size_t i = index; i < (size_t)N; i |= i + 1)
+      tree[i] = tree[i] + delta;
+}
+
+/*********************************************
+ * FENWICK :: PREFIX SUM
+ * Add up the slots that together cover [0, count)
+ *    INPUT  : how many values from the front
+ *    COST   : O(log N)
+ *********************************************/
+template <typename T, int N>
+T fenwick <T, N> :: prefix_sum(size_t count) const
+{
+   if (count > (size_t)N)
+      throw std::out_of_range("Index out of range.");
+   T sum = T();
+   for (size_t i = count; i > 0; i &= i - 1)
+      sum = sum + tree[i - 1];
+   return sum;
+}
+
+}; // namespace custom
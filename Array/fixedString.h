@@ -0,0 +1,283 @@
+/***********************************************************************
+ * Header:
+ *    Fixed String
+ * Summary:
+ *    A short string that lives entirely inside the object: no heap,
+ *    no pointer to chase, and a hash that is always ready
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       fixed_string : up to N characters in a custom::array<char, N>
+ *
+ *    The characters past the length are always zero. That lets two
+ *    strings be compared as N bytes with one memcmp, which the
+ *    compiler turns into a few word compares for small N. The
+ *    FNV-1a state is kept up to date as characters are added, so
+ *    hashing a fixed_string does not read the characters at all.
+ *
+ *       constexpr custom::fixed_string<16> name("GET");
+ *       std::unordered_map<custom::fixed_string<16>, int> counts;
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint64_t
+#include <cstring>       // for memcmp
+#include <functional>    // for std::hash
+#include <stdexcept>     // for std::length_error and std::out_of_range
+#include <string_view>   // for std::string_view
+#include "array.h"
+#include "staticMap.h"   // for mix and static_hash
+
+class TestFixedString; // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * FIXED STRING
+ * Up to N characters stored inline, with the length
+ * and the hash beside them
+ ***********************************************/
+template <int N>
+class fixed_string
+{
+   friend class ::TestFixedString; // give unit tests access to the privates
+
+   static_assert(N > 0, "fixed_string needs room for at least one character");
+public:
+   typedef char         value_type;
+   typedef size_t       size_type;
+   typedef const char * const_iterator;
+
+   //
+   // Construct
+   //
+
+   constexpr fixed_string() : chars(), length(0), fnv(fnvBasis) { }
+
+   // From a string literal or a char buffer, up to the first zero;
+   // an array too long to fit does not compile
+   template <int M>
+   constexpr fixed_string(const char (&literal)[M]) : chars(), length(0), fnv(fnvBasis)
+   {
+      static_assert(M - 1 <= N, "string literal is too long for this fixed_string");
+      size_t num = 0;
+      while (num < (size_t)(M - 1) && literal[num] != '\0')
+         num++;
+      append(std::string_view(literal, num));
+   }
+
+   // From any characters; throws std::length_error if there are too many
+   constexpr explicit fixed_string(std::string_view s) : chars(), length(0), fnv(fnvBasis)
+   {
+      append(s);
+   }
+
+   //
+   // Access
+   //
+
+   constexpr char operator [] (size_t index) const { return chars[index]; }
+   constexpr char at(size_t index) const
+   {
+      if (index >= length)
+         throw std::out_of_range("Index out of range.");
+      return chars[index];
+   }
+   constexpr char front() const { return chars[0];          }
+   constexpr char back()  const { return chars[length - 1]; }
+   constexpr const char * data() const { return chars.data(); }
+
+   constexpr std::string_view view() const
+   {
+      return std::string_view(chars.data(), length);
+   }
+   constexpr operator std::string_view () const { return view(); }
+
+   //
+   // Iterator
+   //
+
+   constexpr const_iterator begin() const { return chars.data();          }
+   constexpr const_iterator end()   const { return chars.data() + length; }
+
+   //
+   // Insert
+   //
+
+   // Add one character; throws std::length_error when full
+   constexpr void push_back(char c)
+   {
+      if (length == (size_t)N)
+         throw std::length_error("fixed_string is full.");
+      chars[length++] = c;
+      fnv = fnvStep(fnv, c);
+   }
+
+   // Add many characters; throws std::length_error and adds none if they do not fit
+   constexpr fixed_string & append(std::string_view s)
+   {
+      if (s.size() > (size_t)N - length)
+         throw std::length_error("fixed_string is full.");
+      for (char c : s)
+      {
+         chars[length++] = c;
+         fnv = fnvStep(fnv, c);
+      }
+      return *this;
+   }
+
+   constexpr fixed_string & operator += (std::string_view s) { return append(s); }
+   constexpr fixed_string & operator += (char c)
+   {
+      push_back(c);
+      return *this;
+   }
+
+   //
+   // Remove
+   //
+
+   // FNV-1a cannot be undone, so removing a character rehashes the rest
+   constexpr void pop_back()
+   {
+      if (length)
+         resize(length - 1);
+   }
+
+   constexpr void clear() { resize(0); }
+
+   //
+   // Status
+   //
+
+   constexpr size_t size()     const { return length;      }
+   constexpr size_t capacity() const { return N;           }
+   constexpr bool   empty()    const { return length == 0; }
+
+   // The hash of the characters, kept up to date as they change
+   constexpr uint64_t hash() const { return mix(fnv); }
+
+   //
+   // Compare
+   //
+
+   // Same length, same hash, then the same N bytes
+   constexpr bool operator == (const fixed_string & rhs) const
+   {
+      return length == rhs.length && fnv == rhs.fnv && chars == rhs.chars;
+   }
+   constexpr bool operator != (const fixed_string & rhs) const { return !(*this == rhs); }
+
+   // The same order as std::string: bytes compared as unsigned
+   constexpr bool operator <  (const fixed_string & rhs) const { return compare(rhs) <  0; }
+   constexpr bool operator >  (const fixed_string & rhs) const { return compare(rhs) >  0; }
+   constexpr bool operator <= (const fixed_string & rhs) const { return compare(rhs) <= 0; }
+   constexpr bool operator >= (const fixed_string & rhs) const { return compare(rhs) >= 0; }
+
+   constexpr int compare(const fixed_string & rhs) const;
+
+private:
+   static constexpr uint64_t fnvBasis = 0xcbf29ce484222325ULL;
+   static constexpr uint64_t fnvPrime = 0x100000001b3ULL;
+
+   static constexpr uint64_t fnvStep(uint64_t hash, char c)
+   {
+      return (hash ^ (unsigned char)c) * fnvPrime;
+   }
+
+   // shorten to count characters, zeroing the rest
+   constexpr void resize(size_t count)
+   {
+      fnv = fnvBasis;
+      for (size_t i = 0; i < count; i++)
+         fnv = fnvStep(fnv, chars[i]);
+      for (size_t i = count; i < length; i++)
+         chars[i] = '\0';
+      length = count;
+   }
+
+   array <char, N> chars;  // the characters, then zeros up to N
+   size_t length;          // how many characters are in use
+   uint64_t fnv;           // FNV-1a of the characters in use
+};
+
+/*********************************************
+ * FIXED STRING :: COMPARE
+ * Order the zero-padded bytes, then the lengths.
+ * Padding makes "ab" sort before "abc" for free;
+ * the length settles "ab" against "ab\0".
+ *    INPUT  : the string to compare with
+ *    OUTPUT : negative, zero or positive like memcmp
+ *    COST   : O(N), a handful of word compares
+ *********************************************/
+template <int N>
+constexpr int fixed_string <N> :: compare(const fixed_string & rhs) const
+{
+   int order = 0;
+   if (!isConstantEvaluated())
+      order = memcmp(chars.data(), rhs.chars.data(), N);
+   else
+   {
+      for (int i = 0; i < N && order == 0; i++)
+         order = (int)(unsigned char)chars[i] - (int)(unsigned char)rhs.chars[i];
+   }
+   if (order != 0)
+      return order;
+   return length < rhs.length ? -1 : (length > rhs.length ? 1 : 0);
+}
+
+/*****************************************************
+ * FIXED STRING EQUALS STRING VIEW
+ ****************************************************/
+template <int N>
+constexpr bool operator == (const fixed_string <N> & lhs, std::string_view rhs)
+{
+   return lhs.view() == rhs;
+}
+
+template <int N>
+constexpr bool operator != (const fixed_string <N> & lhs, std::string_view rhs)
+{
+   return !(lhs == rhs);
+}
+
+/*****************************************************
+ * STATIC HASH : FIXED STRING
+ * So a fixed_string can be a static_map key
+ ****************************************************/
+template <int N>
+struct static_hash <fixed_string <N> >
+{
+   constexpr uint64_t operator () (const fixed_string <N> & key, uint64_t seed) const
+   {
+      return mix(key.hash() ^ (seed * 0x9e3779b97f4a7c15ULL));
+   }
+};
+
+}; // namespace custom
+
+/*****************************************************
+ * HASH : FIXED STRING
+ * So a fixed_string can be an unordered_map key
+ ****************************************************/
+namespace std
+{
+template <int N>
+struct hash <custom::fixed_string <N> >
+{
+   size_t operator () (const custom::fixed_string <N> & key) const noexcept
+   {
+      return (size_t)key.hash();
+   }
+};
+}; // namespace std
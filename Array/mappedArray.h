@@ -0,0 +1,476 @@
+/***********************************************************************
+ * Header:
+ *    Mapped Array
+ * Summary:
+ *    Read-only views of fixed-size records, either in memory or
+ *    mapped straight from a file
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       array_view         : size() elements of T that someone else owns
+ *       mapped_array       : a file of T mapped into memory
+ *       mapped_header      : what comes before the elements in the file
+ *       write_mapped_array : write a file that mapped_array can open
+ *
+ *    Opening a mapped_array reads nothing but the header: the
+ *    operating system pages the elements in the first time they
+ *    are touched, and drops them again under memory pressure. The
+ *    file layout is
+ *
+ *       +--------+---------+-----------+-----------+-----
+ *       | header | padding | element 0 | element 1 | ...
+ *       +--------+---------+-----------+-----------+-----
+ *
+ *    where the padding puts element 0 on an alignment boundary.
+ *    The file is in the byte order of the machine that wrote it.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <cstring>      // for memcmp
+#include <fstream>      // for std::ofstream, used by write_mapped_array
+#include <stdexcept>    // for std::out_of_range and std::runtime_error
+#include <string>       // for std::string, in the error messages
+#include <type_traits>  // for std::is_trivially_copyable
+#include "array.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>    // for CreateFileMapping and MapViewOfFile
+#else
+#include <fcntl.h>      // for open
+#include <sys/mman.h>   // for mmap and madvise
+#include <sys/stat.h>   // for fstat
+#include <unistd.h>     // for close
+#endif
+
+class TestMappedArray; // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * ARRAY VIEW
+ * A read-only window onto size() contiguous
+ * elements owned by someone else. Copying a view
+ * copies the pointer, not the elements.
+ ***********************************************/
+template <typename T>
+class array_view
+{
+   friend class ::TestMappedArray; // give unit tests access to the privates
+public:
+   typedef T value_type;
+   typedef typename array <T, 1> :: const_iterator         const_iterator;
+   typedef typename array <T, 1> :: const_reverse_iterator const_reverse_iterator;
+   typedef const_iterator iterator;
+
+   //
+   // Construct
+   //
+
+   array_view() : pElements(nullptr), numElements(0) { }
+   array_view(const T * pElements, size_t numElements) :
+      pElements(pElements), numElements(numElements)
+   {
+   }
+   template <int N>
+   array_view(const array <T, N> & rhs) :
+      pElements(rhs.data()), numElements(N)
+   {
+   }
+
+   //
+   // Iterator
+   //
+
+   const_iterator begin()          const { return const_iterator(pElements);               }
+   const_iterator end()            const { return const_iterator(pElements + numElements); }
+   const_iterator cbegin()         const { return begin();                                 }
+   const_iterator cend()           const { return end();                                   }
+   const_reverse_iterator rbegin() const { return const_reverse_iterator(end());           }
+   const_reverse_iterator rend()   const { return const_reverse_iterator(begin());         }
+
+   //
+   // Access
+   //
+
+   const T & operator [] (size_t index) const
+   {
+      return pElements[index];
+   }
+   const T & at(size_t index) const
+   {
+      if (index >= numElements)
+         throw std::out_of_range("Index out of range.");
+      return pElements[index];
+   }
+   const T & front() const { return pElements[0];               }
+   const T & back()  const { return pElements[numElements - 1]; }
+   const T * data()  const { return pElements;                  }
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   const T * pElements;  // the first element
+   size_t numElements;   // how many there are
+};
+
+/************************************************
+ * MAPPED HEADER
+ * The first bytes of a mapped_array file
+ ***********************************************/
+struct mapped_header
+{
+   char     magic[8];      // always mapped_magic
+   uint64_t element_size;  // sizeof(T) of the writer
+   uint64_t count;         // the number of elements
+   uint64_t alignment;     // element 0 starts at a multiple of this
+};
+
+// Identifies a mapped_array file, version 1
+const char mapped_magic[8] = { 'C', 'A', 'R', 'R', 'A', 'Y', '0', '1' };
+
+// Where element 0 starts for a given alignment
+inline uint64_t mappedOffset(uint64_t alignment)
+{
+   return (sizeof(mapped_header) + alignment - 1) / alignment * alignment;
+}
+
+// The largest alignment a mapping can promise: the mapping itself
+// starts on a page boundary and no further
+inline uint64_t mappedPageSize()
+{
+#if defined(_WIN32)
+   SYSTEM_INFO info;
+   GetSystemInfo(&info);
+   return info.dwPageSize;
+#else
+   return (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+/************************************************
+ * ACCESS ADVICE
+ * How the elements of a mapped_array will be read,
+ * so the operating system can read ahead or not
+ ***********************************************/
+enum class access_advice
+{
+   normal,      // the default read-ahead
+   sequential,  // front to back: read ahead aggressively, drop pages behind
+   random,      // scattered lookups: do not read ahead
+   will_need    // start paging the whole file in now
+};
+
+/************************************************
+ * MAPPED ARRAY
+ * The elements of a file written by write_mapped_array,
+ * mapped read-only into memory. Owns the mapping,
+ * so it may be moved but not copied.
+ ***********************************************/
+template <typename T>
+class mapped_array
+{
+   friend class ::TestMappedArray; // give unit tests access to the privates
+
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "mapped_array elements must be trivially copyable");
+public:
+   typedef T value_type;
+   typedef typename array_view <T> :: const_iterator         const_iterator;
+   typedef typename array_view <T> :: const_reverse_iterator const_reverse_iterator;
+   typedef const_iterator iterator;
+
+   //
+   // Construct
+   //
+
+   explicit mapped_array(const char * path,
+                         access_advice advice = access_advice::normal);
+   mapped_array(mapped_array && rhs) :
+      pMapping(rhs.pMapping), mappingSize(rhs.mappingSize), elements(rhs.elements)
+   {
+      rhs.pMapping = nullptr;
+      rhs.mappingSize = 0;
+      rhs.elements = array_view <T>();
+   }
+   mapped_array(const mapped_array & rhs) = delete;
+   mapped_array & operator = (const mapped_array & rhs) = delete;
+   ~mapped_array() { unmap(); }
+
+   //
+   // Iterator
+   //
+
+   const_iterator begin()          const { return elements.begin();  }
+   const_iterator end()            const { return elements.end();    }
+   const_iterator cbegin()         const { return elements.cbegin(); }
+   const_iterator cend()           const { return elements.cend();   }
+   const_reverse_iterator rbegin() const { return elements.rbegin(); }
+   const_reverse_iterator rend()   const { return elements.rend();   }
+
+   //
+   // Access
+   //
+
+   const T & operator [] (size_t index) const { return elements[index];    }
+   const T & at(size_t index)           const { return elements.at(index); }
+   const T & front()                    const { return elements.front();   }
+   const T & back()                     const { return elements.back();    }
+   const T * data()                     const { return elements.data();    }
+
+   // The elements as a view, valid while this mapped_array lives
+   array_view <T> view() const { return elements; }
+
+   // Tell the operating system how the elements will be read
+   void advise(access_advice advice);
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return elements.size();  }
+   bool   empty() const { return elements.empty(); }
+
+private:
+   // map the whole file read-only, returning its address and size
+   static const void * map(const char * path, size_t & size);
+   void unmap();
+
+   // complain about the file and give the mapping back
+   void fail(const char * path, const char * problem)
+   {
+      unmap();
+      throw std::runtime_error(std::string(path) + ": " + problem);
+   }
+
+   const void * pMapping;   // the start of the file in memory
+   size_t mappingSize;      // the size of the file
+   array_view <T> elements; // the elements after the header
+};
+
+/*********************************************
+ * MAPPED ARRAY :: CONSTRUCTOR
+ * Map the file and check its header. Only the
+ * header's page is read now.
+ *    INPUT  : the file and how it will be read
+ *    COST   : O(1)
+ *********************************************/
+template <typename T>
+mapped_array <T> :: mapped_array(const char * path, access_advice advice) :
+   pMapping(nullptr), mappingSize(0), elements()
+{
+   pMapping = map(path, mappingSize);
+
+   if (mappingSize < sizeof(mapped_header))
+      fail(path, "too small for a mapped_array header");
+   const mapped_header & header = *static_cast<const mapped_header *>(pMapping);
+   if (memcmp(header.magic, mapped_magic, sizeof(mapped_magic)) != 0)
+      fail(path, "not a mapped_array file");
+   if (header.element_size != sizeof(T))
+      fail(path, "element size does not match");
+   if (header.alignment == 0 || (header.alignment & (header.alignment - 1)) ||
+       header.alignment < alignof(T) || header.alignment > mappedPageSize())
+      fail(path, "bad element alignment");
+
+   uint64_t offset = mappedOffset(header.alignment);
+   if (offset > mappingSize || header.count > (mappingSize - offset) / sizeof(T))
+      fail(path, "truncated");
+
+   elements = array_view <T>(reinterpret_cast<const T *>(
+      static_cast<const char *>(pMapping) + offset), (size_t)header.count);
+   if (advice != access_advice::normal)
+      advise(advice);
+}
+
+#if defined(_WIN32)
+
+/*********************************************
+ * MAPPED ARRAY :: MAP  (Windows)
+ * The view keeps the file open, so both handles
+ * can be closed as soon as it exists.
+ *********************************************/
+template <typename T>
+const void * mapped_array <T> :: map(const char * path, size_t & size)
+{
+   HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (hFile == INVALID_HANDLE_VALUE)
+      throw std::runtime_error(std::string(path) + ": cannot open");
+
+   LARGE_INTEGER fileSize;
+   if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+   {
+      CloseHandle(hFile);
+      throw std::runtime_error(std::string(path) + ": too small for a mapped_array header");
+   }
+
+   HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   const void * p = hMapping ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+   if (hMapping)
+      CloseHandle(hMapping);
+   CloseHandle(hFile);
+   if (p == nullptr)
+      throw std::runtime_error(std::string(path) + ": cannot map");
+
+   size = (size_t)fileSize.QuadPart;
+   return p;
+}
+
+/*********************************************
+ * MAPPED ARRAY :: UNMAP  (Windows)
+ *********************************************/
+template <typename T>
+void mapped_array <T> :: unmap()
+{
+   if (pMapping)
+      UnmapViewOfFile(pMapping);
+   pMapping = nullptr;
+   mappingSize = 0;
+   elements = array_view <T>();
+}
+
+/*********************************************
+ * MAPPED ARRAY :: ADVISE  (Windows)
+ * Windows only takes read-ahead hints when the file
+ * is opened, so all we can do is fault it in early.
+ *********************************************/
+template <typename T>
+void mapped_array <T> :: advise(access_advice advice)
+{
+#if _WIN32_WINNT >= 0x0602
+   if (advice == access_advice::will_need && pMapping)
+   {
+      WIN32_MEMORY_RANGE_ENTRY range = { const_cast<void *>(pMapping), mappingSize };
+      PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+   }
+#endif
+}
+
+#else
+
+/*********************************************
+ * MAPPED ARRAY :: MAP  (POSIX)
+ * The mapping keeps the file open, so the file
+ * descriptor can be closed as soon as it exists.
+ *********************************************/
+template <typename T>
+const void * mapped_array <T> :: map(const char * path, size_t & size)
+{
+   int fd = open(path, O_RDONLY);
+   if (fd < 0)
+      throw std::runtime_error(std::string(path) + ": cannot open");
+
+   struct stat status;
+   if (fstat(fd, &status) != 0 || status.st_size == 0)
+   {
+      close(fd);
+      throw std::runtime_error(std::string(path) + ": too small for a mapped_array header");
+   }
+
+   void * p = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (p == MAP_FAILED)
+      throw std::runtime_error(std::string(path) + ": cannot map");
+
+   size = (size_t)status.st_size;
+   return p;
+}
+
+/*********************************************
+ * MAPPED ARRAY :: UNMAP  (POSIX)
+ *********************************************/
+template <typename T>
+void mapped_array <T> :: unmap()
+{
+   if (pMapping)
+      munmap(const_cast<void *>(pMapping), mappingSize);
+   pMapping = nullptr;
+   mappingSize = 0;
+   elements = array_view <T>();
+}
+
+/*********************************************
+ * MAPPED ARRAY :: ADVISE  (POSIX)
+ * Pass the hint to madvise. It is only a hint, so
+ * a kernel that ignores it is not an error.
+ *********************************************/
+template <typename T>
+void mapped_array <T> :: advise(access_advice advice)
+{
+   if (pMapping == nullptr)
+      return;
+
+   int flag = MADV_NORMAL;
+   switch (advice)
+   {
+      case access_advice::normal:     flag = MADV_NORMAL;     break;
+      case access_advice::sequential: flag = MADV_SEQUENTIAL; break;
+      case access_advice::random:     flag = MADV_RANDOM;     break;
+      case access_advice::will_need:  flag = MADV_WILLNEED;   break;
+   }
+   madvise(const_cast<void *>(pMapping), mappingSize, flag);
+}
+
+#endif // _WIN32
+
+/*****************************************************
+ * WRITE MAPPED ARRAY
+ * Write count elements to a file that mapped_array
+ * can open, with element 0 on an alignment boundary
+ *    INPUT  : the file, the elements and the alignment,
+ *             a power of two no bigger than a page
+ ****************************************************/
+template <typename T>
+void write_mapped_array(const char * path, const T * pElements, size_t count,
+                        size_t alignment = alignof(T))
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "mapped_array elements must be trivially copyable");
+   if (alignment < alignof(T) || (alignment & (alignment - 1)) ||
+       alignment > mappedPageSize())
+      throw std::invalid_argument("Alignment must be a power of two from alignof(T) to a page.");
+
+   mapped_header header = {};
+   memcpy(header.magic, mapped_magic, sizeof(mapped_magic));
+   header.element_size = sizeof(T);
+   header.count        = count;
+   header.alignment    = alignment;
+
+   std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+   fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+   for (uint64_t i = sizeof(header); i < mappedOffset(alignment); i++)
+      fout.put('\0');
+   fout.write(reinterpret_cast<const char *>(pElements), count * sizeof(T));
+   if (!fout)
+      throw std::runtime_error(std::string(path) + ": cannot write");
+}
+
+template <typename T>
+void write_mapped_array(const char * path, const array_view <T> & elements,
+                        size_t alignment = alignof(T))
+{
+   write_mapped_array(path, elements.data(), elements.size(), alignment);
+}
+
+}; // namespace custom
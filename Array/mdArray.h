@@ -0,0 +1,418 @@
+/***********************************************************************
+ * Header:
+ *    MD Array
+ * Summary:
+ *    Two-dimensional arrays and views over custom::array storage
+ *    with a choice of memory layout
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       row_major         : element (r, c) at r * C + c
+ *       column_major      : element (r, c) at c * R + r
+ *       blocked           : TR x TC tiles, each stored contiguously
+ *       md_view           : an R x C window onto someone else's storage
+ *       md_array          : an R x C matrix that owns its storage
+ *       md_tile           : one tile of a view, clipped at the edges
+ *       md_tile_iterator  : an iterator through the tiles of a view
+ *       transpose         : dst = src^T, one tile at a time
+ *       multiply          : c = a * b, one tile at a time
+ *
+ *    A loop that walks a matrix against its layout touches a new
+ *    cache line on every step. Working a tile at a time keeps the
+ *    lines a tile needs in L1 until the tile is finished, and the
+ *    blocked layout makes every tile one contiguous run of memory.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t and std::ptrdiff_t
+#include <iterator>     // for std::forward_iterator_tag
+#include <stdexcept>    // for std::out_of_range
+#include <type_traits>  // for std::enable_if and std::is_convertible
+#include "array.h"
+
+class TestMdArray; // forward declaration for unit tests
+
+namespace custom
+{
+
+// The tile edge the tiled algorithms use unless told otherwise.
+// Three 32 x 32 tiles of float fill 12K, well inside a 32K L1.
+const int md_tile_size = 32;
+
+/************************************************
+ * ROW MAJOR
+ * Each row is contiguous, like a C array
+ ***********************************************/
+struct row_major
+{
+   template <int R, int C>
+   struct mapping
+   {
+      static const int required_size = R * C;
+      static constexpr size_t index(size_t r, size_t c)
+      {
+         return r * C + c;
+      }
+   };
+};
+
+/************************************************
+ * COLUMN MAJOR
+ * Each column is contiguous, like Fortran
+ ***********************************************/
+struct column_major
+{
+   template <int R, int C>
+   struct mapping
+   {
+      static const int required_size = R * C;
+      static constexpr size_t index(size_t r, size_t c)
+      {
+         return c * R + r;
+      }
+   };
+};
+
+/************************************************
+ * BLOCKED
+ * TR x TC tiles laid out row by row, each tile
+ * itself row-major. The last row and column of
+ * tiles are padded out to a whole tile.
+ ***********************************************/
+template <int TR, int TC>
+struct blocked
+{
+   static_assert(TR > 0 && TC > 0, "tiles need at least one element");
+
+   static const int tile_rows = TR;
+   static const int tile_cols = TC;
+
+   template <int R, int C>
+   struct mapping
+   {
+      static const int tilesDown     = (R + TR - 1) / TR;
+      static const int tilesAcross   = (C + TC - 1) / TC;
+      static const int required_size = tilesDown * tilesAcross * TR * TC;
+      static constexpr size_t index(size_t r, size_t c)
+      {
+         return ((r / TR) * tilesAcross + c / TC) * (TR * TC) +
+                (r % TR) * TC + c % TC;
+      }
+   };
+};
+
+template <typename View>
+class md_tile;
+template <typename View, int TR, int TC>
+class md_tile_iterator;
+template <typename View, int TR, int TC>
+class md_tile_range;
+
+/************************************************
+ * MD VIEW
+ * R rows by C columns of T in someone else's
+ * storage, laid out according to Layout. Copying
+ * a view copies the pointer, not the elements.
+ ***********************************************/
+template <typename T, int R, int C, typename Layout = row_major>
+class md_view
+{
+   friend class ::TestMdArray; // give unit tests access to the privates
+public:
+   typedef T value_type;
+   typedef Layout layout_type;
+   typedef typename Layout::template mapping<R, C> mapping_type;
+
+   // The number of elements the storage must hold
+   static const int required_size = mapping_type::required_size;
+
+   //
+   // Construct
+   //
+
+   md_view() : p(nullptr) { }
+   explicit md_view(T * p) : p(p) { }
+
+   // A view of non-const elements converts to a view of const ones
+   template <typename U, typename = typename
+             std::enable_if<std::is_convertible<U *, T *>::value>::type>
+   md_view(const md_view <U, R, C, Layout> & rhs) : p(rhs.data()) { }
+
+   //
+   // Access
+   //
+
+   T & operator () (size_t r, size_t c) const
+   {
+      return p[mapping_type::index(r, c)];
+   }
+   T & at(size_t r, size_t c) const
+   {
+      if (r >= R || c >= C)
+         throw std::out_of_range("Index out of range.");
+      return (*this)(r, c);
+   }
+   T * data() const { return p; }
+
+   // Walk the view one TR x TC tile at a time
+   template <int TR, int TC>
+   md_tile_range <md_view, TR, TC> tiles() const
+   {
+      return md_tile_range <md_view, TR, TC>(*this);
+   }
+
+   //
+   // Status
+   //
+
+   static constexpr size_t rows() { return R;     }
+   static constexpr size_t cols() { return C;     }
+   static constexpr size_t size() { return R * C; }
+
+private:
+   T * p;  // element (0, 0) of the storage, not necessarily of the layout
+};
+
+/************************************************
+ * MD ARRAY
+ * R rows by C columns of T, stored in a
+ * custom::array and laid out according to Layout
+ ***********************************************/
+template <typename T, int R, int C, typename Layout = row_major>
+class md_array
+{
+   friend class ::TestMdArray; // give unit tests access to the privates
+public:
+   typedef T value_type;
+   typedef Layout layout_type;
+   typedef md_view <T, R, C, Layout>       view_type;
+   typedef md_view <const T, R, C, Layout> const_view_type;
+
+   //
+   // Access
+   //
+
+   T & operator () (size_t r, size_t c)
+   {
+      return storage[view_type::mapping_type::index(r, c)];
+   }
+   const T & operator () (size_t r, size_t c) const
+   {
+      return storage[view_type::mapping_type::index(r, c)];
+   }
+   T & at(size_t r, size_t c)             { return view().at(r, c); }
+   const T & at(size_t r, size_t c) const { return view().at(r, c); }
+
+   // The whole matrix as a view, for the tiled algorithms
+   view_type view()             { return view_type(storage.data());       }
+   const_view_type view() const { return const_view_type(storage.data()); }
+
+   // The raw storage, including any padding the layout needs
+   T * data()             { return storage.data(); }
+   const T * data() const { return storage.data(); }
+
+   //
+   // Modify
+   //
+
+   void fill(const T & value) { storage.fill(value); }
+
+   //
+   // Status
+   //
+
+   static constexpr size_t rows() { return R;     }
+   static constexpr size_t cols() { return C;     }
+   static constexpr size_t size() { return R * C; }
+
+private:
+   array <T, view_type::required_size> storage;
+};
+
+/**************************************************
+ * MD TILE
+ * The rows() x cols() elements of a view starting at
+ * (row(), col()). Tiles on the right and bottom edges
+ * are clipped to the view.
+ *************************************************/
+template <typename View>
+class md_tile
+{
+   friend class ::TestMdArray; // give unit tests access to the privates
+public:
+   typedef typename View::value_type value_type;
+
+   md_tile(const View & view, size_t row, size_t col, size_t numRows, size_t numCols) :
+      view(view), firstRow(row), firstCol(col), numRows(numRows), numCols(numCols)
+   {
+   }
+
+   // Element (r, c) of the tile, which is (row() + r, col() + c) of the view
+   value_type & operator () (size_t r, size_t c) const
+   {
+      return view(firstRow + r, firstCol + c);
+   }
+
+   size_t row()  const { return firstRow; }
+   size_t col()  const { return firstCol; }
+   size_t rows() const { return numRows;  }
+   size_t cols() const { return numCols;  }
+
+private:
+   View view;
+   size_t firstRow;
+   size_t firstCol;
+   size_t numRows;
+   size_t numCols;
+};
+
+/**************************************************
+ * MD TILE ITERATOR
+ * Visits the TR x TC tiles of a view left to right,
+ * then top to bottom
+ *************************************************/
+template <typename View, int TR, int TC>
+class md_tile_iterator
+{
+   friend class ::TestMdArray; // give unit tests access to the privates
+
+   static_assert(TR > 0 && TC > 0, "tiles need at least one element");
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef md_tile <View>            value_type;
+   typedef std::ptrdiff_t            difference_type;
+   typedef md_tile <View>            reference;
+   typedef void                      pointer;
+
+   md_tile_iterator() : view(), row(0), col(0) { }
+   md_tile_iterator(const View & view, size_t row, size_t col) :
+      view(view), row(row), col(col)
+   {
+   }
+
+   bool operator == (const md_tile_iterator & rhs) const
+   {
+      return row == rhs.row && col == rhs.col;
+   }
+   bool operator != (const md_tile_iterator & rhs) const
+   {
+      return !(*this == rhs);
+   }
+
+   reference operator * () const
+   {
+      size_t numRows = View::rows() - row < (size_t)TR ? View::rows() - row : TR;
+      size_t numCols = View::cols() - col < (size_t)TC ? View::cols() - col : TC;
+      return reference(view, row, col, numRows, numCols);
+   }
+
+   md_tile_iterator & operator ++ ()
+   {
+      col += TC;
+      if (col >= View::cols())
+      {
+         col = 0;
+         row += TR;
+      }
+      return *this;
+   }
+   md_tile_iterator operator ++ (int postfix)
+   {
+      md_tile_iterator temp = *this;
+      ++(*this);
+      return temp;
+   }
+
+private:
+   View view;   // the view being tiled
+   size_t row;  // the top row of the current tile
+   size_t col;  // the left column of the current tile
+};
+
+/**************************************************
+ * MD TILE RANGE
+ * Lets a view's tiles be used in a range-based for
+ *************************************************/
+template <typename View, int TR, int TC>
+class md_tile_range
+{
+public:
+   typedef md_tile_iterator <View, TR, TC> iterator;
+
+   explicit md_tile_range(const View & view) : view(view) { }
+
+   iterator begin() const { return iterator(view, 0, 0); }
+   iterator end()   const
+   {
+      // the row just past the last row of tiles
+      size_t rowEnd = (View::rows() + TR - 1) / TR * TR;
+      return iterator(view, View::cols() ? rowEnd : 0, 0);
+   }
+
+private:
+   View view;
+};
+
+/*********************************************
+ * TRANSPOSE
+ * dst(c, r) = src(r, c), one TS x TS tile of src
+ * at a time so that neither the rows of one
+ * nor the columns of the other leave the cache.
+ *    INPUT  : src is R x C, dst is C x R, any layouts
+ *    COST   : O(R * C)
+ *********************************************/
+template <int TS = md_tile_size, typename T, typename U,
+          int R, int C, typename L1, typename L2>
+void transpose(const md_view <T, R, C, L1> & src, const md_view <U, C, R, L2> & dst)
+{
+   for (auto && tile : src.template tiles<TS, TS>())
+      for (size_t r = 0; r < tile.rows(); r++)
+         for (size_t c = 0; c < tile.cols(); c++)
+            dst(tile.col() + c, tile.row() + r) = tile(r, c);
+}
+
+/*********************************************
+ * MULTIPLY
+ * c = a * b. The loops are blocked by TS in all
+ * three dimensions so that the three tiles being
+ * worked on stay in L1, and the innermost loop
+ * walks a row of b and c.
+ *    INPUT  : a is R x M, b is M x K, c is R x K
+ *    COST   : O(R * M * K)
+ *********************************************/
+template <int TS = md_tile_size, typename T, typename TA, typename TB,
+          int R, int M, int K, typename LA, typename LB, typename LC>
+void multiply(const md_view <TA, R, M, LA> & a,
+              const md_view <TB, M, K, LB> & b,
+              const md_view <T,  R, K, LC> & c)
+{
+   for (size_t i = 0; i < (size_t)R; i++)
+      for (size_t j = 0; j < (size_t)K; j++)
+         c(i, j) = T();
+
+   for (size_t i0 = 0; i0 < (size_t)R; i0 += TS)
+      for (size_t m0 = 0; m0 < (size_t)M; m0 += TS)
+         for (size_t j0 = 0; j0 < (size_t)K; j0 += TS)
+         {
+            size_t iEnd = i0 + TS < (size_t)R ? i0 + TS : R;
+            size_t mEnd = m0 + TS < (size_t)M ? m0 + TS : M;
+            size_t jEnd = j0 + TS < (size_t)K ? j0 + TS : K;
+            for (size_t i = i0; i < iEnd; i++)
+               for (size_t m = m0; m < mEnd; m++)
+               {
+                  T aim = a(i, m);
+                  for (size_t j = j0; j < jEnd; j++)
+                     c(i, j) += aim * b(m, j);
+               }
+         }
+}
+
+}; // namespace custom
@@ -0,0 +1,145 @@
+/***********************************************************************
+ * Header:
+ *    Search
+ * Summary:
+ *    Binary search over a sorted custom::array without
+ *    unpredictable branches
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the definition of:
+ *       lower_bound : the first element not less than a value
+ *       upper_bound : the first element greater than a value
+ *       equal_range : the elements equal to a value
+ *
+ *    Each step of the search halves the range with a conditional
+ *    move rather than a branch, so a step costs the same whether
+ *    the key is found left or right. While a step waits on memory,
+ *    both elements the next step could look at are prefetched.
+ *    Once the range is small, the rest is a vectorized count of
+ *    the elements on the left side of the value.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <utility>      // for std::pair
+#include "array.h"
+#include "simd.h"       // for simd::count_less and simd::count_less_equal
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>  // for _mm_prefetch
+#endif
+
+namespace custom
+{
+
+// The size of range finished with a linear scan instead of halving
+const size_t search_linear_limit = 16;
+
+/*****************************************************
+ * PREFETCH
+ * Ask for the cache line holding p before it is needed
+ ****************************************************/
+inline void prefetch(const void * p)
+{
+#if defined(__GNUC__)
+   __builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+   _mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#else
+   (void)p;
+#endif
+}
+
+/*****************************************************
+ * BOUND
+ * The index of the first of the n sorted elements at
+ * p that is on the right of value. Upper decides which
+ * side equal elements fall on.
+ *
+ * The answer is always in [base, base + n]. Each step
+ * keeps the half it lies in with a select, not a branch.
+ ****************************************************/
+template <bool Upper, typename T>
+size_t bound(const T * p, size_t n, const T & value)
+{
+   const T * base = p;
+   while (n > search_linear_limit)
+   {
+      size_t half = n / 2;
+      size_t nextHalf = (n - half) / 2;
+      prefetch(base + nextHalf);
+      prefetch(base + half + nextHalf);
+      bool right = Upper ? !(value < base[half]) : base[half] < value;
+      base = right ? base + half : base;
+      n -= half;
+   }
+
+   size_t left = Upper ? simd::count_less_equal(base, n, value) :
+                         simd::count_less(base, n, value);
+   return (size_t)(base - p) + left;
+}
+
+/*****************************************************
+ * LOWER BOUND
+ * The first element of a sorted array that is not
+ * less than value, or end() if there is none
+ *    COST   : O(log N), with no branch that depends on the data
+ ****************************************************/
+template <typename T, int N>
+typename array <T, N> :: iterator lower_bound(array <T, N> & a, const T & value)
+{
+   return a.begin() + bound<false>(a.data(), N, value);
+}
+
+template <typename T, int N>
+typename array <T, N> :: const_iterator lower_bound(const array <T, N> & a, const T & value)
+{
+   return a.begin() + bound<false>(a.data(), N, value);
+}
+
+/*****************************************************
+ * UPPER BOUND
+ * The first element of a sorted array that is greater
+ * than value, or end() if there is none
+ *    COST   : O(log N), with no branch that depends on the data
+ ****************************************************/
+template <typename T, int N>
+typename array <T, N> :: iterator upper_bound(array <T, N> & a, const T & value)
+{
+   return a.begin() + bound<true>(a.data(), N, value);
+}
+
+template <typename T, int N>
+typename array <T, N> :: const_iterator upper_bound(const array <T, N> & a, const T & value)
+{
+   return a.begin() + bound<true>(a.data(), N, value);
+}
+
+/*****************************************************
+ * EQUAL RANGE
+ * The elements of a sorted array equal to value, as
+ * [lower_bound, upper_bound)
+ *    COST   : O(log N)
+ ****************************************************/
+template <typename T, int N>
+std::pair<typename array <T, N> :: iterator, typename array <T, N> :: iterator>
+equal_range(array <T, N> & a, const T & value)
+{
+   return std::make_pair(lower_bound(a, value), upper_bound(a, value));
+}
+
+template <typename T, int N>
+std::pair<typename array <T, N> :: const_iterator, typename array <T, N> :: const_iterator>
+equal_range(const array <T, N> & a, const T & value)
+{
+   return std::make_pair(lower_bound(a, value), upper_bound(a, value));
+}
+
+}; // namespace custom
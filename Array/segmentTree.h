@@ -0,0 +1,323 @@
+/***********************************************************************
+ * Header:
+ *    Segment Tree
+ * Summary:
+ *    Range queries and range updates over N values, both in
+ *    O(log N), with the tree stored flat in custom::array
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       sum_op       : combine with +
+ *       min_op       : combine with min
+ *       max_op       : combine with max
+ *       segment_tree : N values, range query with Op, range add
+ *
+ *    Node 1 is the root, the children of node i are 2i and 2i + 1,
+ *    and the leaves are nodes P .. P + N - 1, where P is N rounded
+ *    up to a power of two. Both operations climb from the leaves
+ *    with a loop, never recursing. A range add leaves a pending
+ *    delta on the few nodes that cover the range, and a query
+ *    pushes those deltas down only along the two paths it uses.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <algorithm>    // for std::min and std::max
+#include <cstddef>      // for size_t
+#include <limits>       // for std::numeric_limits
+#include <stdexcept>    // for std::out_of_range
+#include "array.h"
+
+class TestSegmentTree; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************
+ * LOG2 CEIL
+ * The number of times n must be halved to reach one
+ ****************************************************/
+constexpr int log2_ceil(int n)
+{
+   int levels = 0;
+   while ((1 << levels) < n)
+      levels++;
+   return levels;
+}
+
+/************************************************
+ * SEGMENT TREE OPERATIONS
+ * What a segment_tree computes over a range:
+ *    identity() : the answer for no values at all
+ *    combine()  : the answer for two neighbouring ranges,
+ *                 left first
+ *    apply()    : the answer for a range of length values
+ *                 after delta is added to each of them
+ ***********************************************/
+template <typename T>
+struct sum_op
+{
+   static constexpr T identity() { return T(); }
+   static constexpr T combine(const T & lhs, const T & rhs) { return lhs + rhs; }
+   static constexpr T apply(const T & value, const T & delta, size_t length)
+   {
+      return value + delta * (T)length;
+   }
+};
+
+template <typename T>
+struct min_op
+{
+   static constexpr T identity() { return std::numeric_limits<T>::max(); }
+   static constexpr T combine(const T & lhs, const T & rhs) { return std::min(lhs, rhs); }
+   static constexpr T apply(const T & value, const T & delta, size_t /* length */)
+   {
+      return value + delta;
+   }
+};
+
+template <typename T>
+struct max_op
+{
+   static constexpr T identity() { return std::numeric_limits<T>::lowest(); }
+   static constexpr T combine(const T & lhs, const T & rhs) { return std::max(lhs, rhs); }
+   static constexpr T apply(const T & value, const T & delta, size_t /* length */)
+   {
+      return value + delta;
+   }
+};
+
+/************************************************
+ * SEGMENT TREE
+ * N values of T. Op answers queries over any range
+ * [first, last); deltas can be added to any range.
+ ***********************************************/
+template <typename T, int N, typename Op = sum_op<T> >
+class segment_tree
+{
+   friend class ::TestSegmentTree; // give unit tests access to the privates
+
+   static_assert(N > 0, "segment_tree needs at least one value");
+public:
+   //
+   // Construct
+   //
+
+   // Every value starts at T()
+   segment_tree() : tree(), pending()
+   {
+      array <T, N> values;
+      values.fill(T());
+      build(values);
+   }
+
+   // Start from existing values in O(N)
+   explicit segment_tree(const array <T, N> & values) : tree(), pending()
+   {
+      build(values);
+   }
+
+   //
+   // Modify
+   //
+
+   // Add delta to every value in [first, last)
+   void add(size_t first, size_t last, const T & delta);
+
+   // Add delta to value index
+   void add(size_t index, const T & delta)
+   {
+      add(index, index + 1, delta);
+   }
+
+   // Make value index equal to value
+   void set(size_t index, const T & value);
+
+   //
+   // Query
+   //
+
+   // Combine the values in [first, last) with Op
+   T query(size_t first, size_t last);
+
+   // The value at index
+   T get(size_t index)
+   {
+      return query(index, index + 1);
+   }
+
+   //
+   // Status
+   //
+
+   size_t size() const { return N; }
+
+private:
+   static const size_t leaves = next_power_of_two(N);  // the first leaf
+   static const int    height = log2_ceil(N);          // levels above the leaves
+
+   void build(const array <T, N> & values);
+
+   // give node, which covers length values, a delta
+   void applyNode(size_t node, const T & delta, size_t length)
+   {
+      tree[node] = Op::apply(tree[node], delta, length);
+      if (node < leaves)
+         pending[node] = pending[node] + delta;
+   }
+
+   // recompute the ancestors of node from their children
+   void pull(size_t node);
+
+   // hand pending deltas down the path from the root to node
+   void push(size_t node);
+
+   void check(size_t first, size_t last) const
+   {
+      if (first > last || last > (size_t)N)
+         throw std::out_of_range("Range out of range.");
+   }
+
+   array <T, 2 * leaves> tree;  // node i's answer; leaves start at P
+   array <T, leaves> pending;   // the delta not yet given to node i's children
+};
+
+/*********************************************
+ * SEGMENT TREE :: BUILD
+ * Fill the leaves, then every parent from the
+ * bottom up
+ *    COST   : O(N)
+ *********************************************/
+template <typename T, int N, typename Op>
+void segment_tree <T, N, Op> :: build(const array <T, N> & values)
+{
+   for (size_t i = 0; i < leaves; i++)
+      tree[leaves + i] = i < (size_t)N ? values[i] : Op::identity();
+   for (size_t node = leaves - 1; node > 0; node--)
+      tree[node] = Op::combine(tree[2 * node], tree[2 * node + 1]);
+   pending.fill(T());
+}
+
+/*********************************************
+ * SEGMENT TREE :: PULL
+ * After node changed, recompute each ancestor from
+ * its children plus its own pending delta
+ *    COST   : O(log N)
+ *********************************************/
+template <typename T, int N, typename Op>
+void segment_tree <T, N, Op> :: pull(size_t node)
+{
+   for (size_t length = 2; node > 1; length *= 2)
+   {
+      node /= 2;
+      tree[node] = Op::apply(Op::combine(tree[2 * node], tree[2 * node + 1]),
+                             pending[node], length);
+   }
+}
+
+/*********************************************
+ * SEGMENT TREE :: PUSH
+ * From the root down to node, give every pending
+ * delta to the two children
+ *    COST   : O(log N)
+ *********************************************/
+template <typename T, int N, typename Op>
+void segment_tree <T, N, Op> :: push(size_t node)
+{
+   for (int shift = height; shift > 0; shift--)
+   {
+      size_t ancestor = node >> shift;
+      if (!(pending[ancestor] == T()))
+      {
+         size_t length = (size_t)1 << (shift - 1);
+         applyNode(2 * ancestor,     pending[ancestor], length);
+         applyNode(2 * ancestor + 1, pending[ancestor], length);
+         pending[ancestor] = T();
+      }
+   }
+}
+
+/*********************************************
+ * SEGMENT TREE :: ADD
+ * Climb from both ends of the range, giving the
+ * delta to each node that lies wholly inside it,
+ * then fix the answers above the two ends
+ *    INPUT  : the range [first, last) and the delta
+ *    COST   : O(log N)
+ *********************************************/
+template <typename T, int N, typename Op>
+void segment_tree <T, N, Op> :: add(size_t first, size_t last, const T & delta)
+{
+   check(first, last);
+   if (first == last)
+      return;
+
+   size_t left  = first + leaves;
+   size_t right = last  + leaves;
+   for (size_t length = 1; left < right; left /= 2, right /= 2, length *= 2)
+   {
+      if (left & 1)
+         applyNode(left++, delta, length);
+      if (right & 1)
+         applyNode(--right, delta, length);
+   }
+   pull(first + leaves);
+   pull(last - 1 + leaves);
+}
+
+/*********************************************
+ * SEGMENT TREE :: SET
+ * Replace one leaf and recompute its ancestors
+ *    COST   : O(log N)
+ *********************************************/
+template <typename T, int N, typename Op>
+void segment_tree <T, N, Op> :: set(size_t index, const T & value)
+{
+   check(index, index + 1);
+   push(index + leaves);
+   tree[index + leaves] = value;
+   pull(index + leaves);
+}
+
+/*********************************************
+ * SEGMENT TREE :: QUERY
+ * Climb from both ends of the range, combining the
+ * nodes that lie wholly inside it. The left and
+ * right answers are kept apart so Op need not
+ * be commutative.
+ *    INPUT  : the range [first, last)
+ *    OUTPUT : Op over the range, identity() if empty
+ *    COST   : O(log N)
+ *********************************************/
+template <typename T, int N, typename Op>
+T segment_tree <T, N, Op> :: query(size_t first, size_t last)
+{
+   check(first, last);
+   if (first == last)
+      return Op::identity();
+
+   size_t left  = first + leaves;
+   size_t right = last  + leaves;
+   push(left);
+   push(right - 1);
+
+   T leftAnswer  = Op::identity();
+   T rightAnswer = Op::identity();
+   for (; left < right; left /= 2, right /= 2)
+   {
+      if (left & 1)
+         leftAnswer = Op::combine(leftAnswer, tree[left++]);
+      if (right & 1)
+         rightAnswer = Op::combine(tree[--right], rightAnswer);
+   }
+   return Op::combine(leftAnswer, rightAnswer);
+}
+
+}; // namespace custom
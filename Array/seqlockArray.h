@@ -0,0 +1,213 @@
+/***********************************************************************
+ * Header:
+ *    Seqlock Array
+ * Summary:
+ *    A fixed array written by one thread and read by many, with
+ *    no locks on either side
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       seqlock_array : N values published by a single writer
+ *
+ *    The writer makes the sequence number odd, stores the values,
+ *    then makes it even again, so a write never waits for anything.
+ *    A reader copies the values between two reads of the sequence
+ *    number and starts over if a write began in between. Readers
+ *    never store to shared memory, so any number of them can copy
+ *    at once without passing cache lines back and forth.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>          // for std::atomic and std::atomic_thread_fence
+#include <cstddef>         // for size_t
+#include <stdexcept>       // for std::out_of_range
+#include <type_traits>     // for std::is_trivially_copyable
+#include "array.h"
+#include "alignedArray.h"  // for cache_line_size
+
+class TestSeqlockArray; // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * SEQLOCK ARRAY
+ * N values of T. Only one thread may store; any
+ * number of threads may load consistent copies.
+ ***********************************************/
+template <typename T, int N>
+class seqlock_array
+{
+   friend class ::TestSeqlockArray; // give unit tests access to the privates
+
+   static_assert(N > 0, "seqlock_array needs at least one value");
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "seqlock_array copies values while they may be changing");
+   static_assert(std::atomic<T>::is_always_lock_free,
+                 "seqlock_array readers must not take a lock to load a value");
+public:
+   //
+   // Construct
+   //
+
+   // Every value starts at T()
+   seqlock_array() : sequence(0)
+   {
+      for (size_t i = 0; i < (size_t)N; i++)
+         values[i].store(T(), std::memory_order_relaxed);
+   }
+
+   explicit seqlock_array(const array <T, N> & rhs) : sequence(0)
+   {
+      for (size_t i = 0; i < (size_t)N; i++)
+         values[i].store(rhs[i], std::memory_order_relaxed);
+   }
+
+   seqlock_array(const seqlock_array & rhs) = delete;
+   seqlock_array & operator = (const seqlock_array & rhs) = delete;
+
+   //
+   // Writer
+   //
+
+   // Publish every value at once
+   void store(const array <T, N> & rhs)
+   {
+      store(0, rhs.data(), (size_t)N);
+   }
+
+   // Publish M values starting at first
+   template <int M>
+   void store(size_t first, const array <T, M> & rhs)
+   {
+      store(first, rhs.data(), (size_t)M);
+   }
+
+   // Publish one value
+   void store(size_t index, const T & value)
+   {
+      store(index, &value, 1);
+   }
+
+   //
+   // Readers
+   //
+
+   // A copy of every value from a single write
+   array <T, N> load() const
+   {
+      array <T, N> copy;
+      load(0, copy.data(), (size_t)N);
+      return copy;
+   }
+
+   // A copy of the M values starting at first, all from a single write
+   template <int M>
+   array <T, M> load(size_t first) const
+   {
+      array <T, M> copy;
+      load(first, copy.data(), (size_t)M);
+      return copy;
+   }
+
+   // One value is always consistent on its own
+   T load(size_t index) const
+   {
+      check(index, 1);
+      return values[index].load(std::memory_order_relaxed);
+   }
+
+   //
+   // Status
+   //
+
+   // How many writes have finished; this is only a snapshot
+   size_t version() const
+   {
+      return sequence.load(std::memory_order_acquire) / 2;
+   }
+
+   size_t size() const { return N; }
+
+private:
+   void store(size_t first, const T * items, size_t count);
+   void load(size_t first, T * items, size_t count) const;
+
+   void check(size_t first, size_t count) const
+   {
+      if (first > (size_t)N || count > (size_t)N - first)
+         throw std::out_of_range("Range out of range.");
+   }
+
+   // odd while a write is in progress; on its own line so that the
+   // values the writer stores do not evict it from the readers' caches
+   alignas(cache_line_size) std::atomic<size_t> sequence;
+
+   // the values, starting on their own cache line
+   alignas(cache_line_size) array <std::atomic<T>, N> values;
+};
+
+/*********************************************
+ * SEQLOCK ARRAY :: STORE
+ * Mark a write in progress, store the values, then
+ * mark it finished. There is no loop, so the writer
+ * never waits on the readers.
+ *    INPUT  : where to start, the values, how many
+ *    COST   : O(count)
+ *********************************************/
+template <typename T, int N>
+void seqlock_array <T, N> :: store(size_t first, const T * items, size_t count)
+{
+   check(first, count);
+   size_t start = sequence.load(std::memory_order_relaxed);
+   sequence.store(start + 1, std::memory_order_relaxed);
+
+   // no value store may be seen before the sequence number is odd
+   std::atomic_thread_fence(std::memory_order_release);
+   for (size_t i = 0; i < count; i++)
+      values[first + i].store(items[i], std::memory_order_relaxed);
+
+   sequence.store(start + 2, std::memory_order_release);
+}
+
+/*********************************************
+ * SEQLOCK ARRAY :: LOAD
+ * Copy the values, then check the sequence number
+ * did not change while we did. Try again if a
+ * write was in progress or finished meanwhile.
+ *    INPUT  : where to start, where to copy, how many
+ *    COST   : O(count) when there is no write
+ *********************************************/
+template <typename T, int N>
+void seqlock_array <T, N> :: load(size_t first, T * items, size_t count) const
+{
+   check(first, count);
+   size_t before;
+   size_t after;
+   do
+   {
+      before = sequence.load(std::memory_order_acquire);
+      if (before & 1)
+      {
+         after = before + 1;  // a write is in progress
+         continue;
+      }
+      for (size_t i = 0; i < count; i++)
+         items[i] = values[first + i].load(std::memory_order_relaxed);
+
+      // no value load may be seen after the second sequence load
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+   }
+   while (before != after);
+}
+
+}; // namespace custom
@@ -0,0 +1,631 @@
+/***********************************************************************
+ * Header:
+ *    SIMD
+ * Summary:
+ *    Vectorized bulk operations over custom::array
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the definition of:
+ *       simd::fill             : assign one value to every element
+ *       simd::sum              : add every element together
+ *       simd::min              : the smallest element
+ *       simd::max              : the largest element
+ *       simd::find             : the index of the first matching element
+ *       simd::count            : the number of matching elements
+ *       simd::count_less       : the number of elements less than a value
+ *       simd::count_less_equal : the number of elements not greater
+ *       simd::add              : element-wise addition of two arrays
+ *       simd::multiply         : element-wise multiplication of two arrays
+ *       simd::bit_and          : element-wise AND of two integer arrays
+ *       simd::bit_or           : element-wise OR of two integer arrays
+ *       simd::bit_xor          : element-wise XOR of two integer arrays
+ *       simd::equal            : are two arrays element-wise equal?
+ *       simd::has_all_bits     : is every bit of a mask also set?
+ *
+ *    The vector width is chosen at compile time from the instruction
+ *    set the compiler is targeting (AVX-512, AVX2/AVX or SSE2/NEON).
+ *    Types that are not integers or floating point numbers, and
+ *    compilers without GNU vector extensions, use the scalar loop.
+ *    Define CUSTOM_SIMD_WIDTH to 0 to force the scalar loop.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstring>      // for std::memcpy
+#include <type_traits>  // for std::is_arithmetic
+#include "array.h"
+
+/*************************************************
+ * CUSTOM SIMD WIDTH
+ * The number of bytes in one vector register
+ *************************************************/
+#ifndef CUSTOM_SIMD_WIDTH
+#if !defined(__GNUC__)
+#define CUSTOM_SIMD_WIDTH 0
+#elif defined(__AVX512F__)
+#define CUSTOM_SIMD_WIDTH 64
+#elif defined(__AVX2__) || defined(__AVX__)
+#define CUSTOM_SIMD_WIDTH 32
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define CUSTOM_SIMD_WIDTH 16
+#else
+#define CUSTOM_SIMD_WIDTH 0
+#endif
+#endif // CUSTOM_SIMD_WIDTH
+
+namespace custom
+{
+namespace simd
+{
+
+/*************************************************
+ * IS VECTORIZABLE
+ * Integers and floating point numbers that fit in
+ * a vector lane. Bool is left to the scalar loop.
+ *************************************************/
+template <typename T>
+struct isVectorizable
+{
+   static const bool value = CUSTOM_SIMD_WIDTH != 0 &&
+                             std::is_arithmetic<T>::value &&
+                             !std::is_same<T, bool>::value &&
+                             sizeof(T) <= 8;
+};
+
+#if CUSTOM_SIMD_WIDTH
+
+/*************************************************
+ * LANE
+ * One vector register full of T
+ *************************************************/
+template <typename T>
+struct lane
+{
+   typedef T vector __attribute__((vector_size(CUSTOM_SIMD_WIDTH)));
+   static const size_t count = CUSTOM_SIMD_WIDTH / sizeof(T);
+
+   // the number of elements covered by whole registers
+   static size_t whole(size_t n)
+   {
+      return n - n % count;
+   }
+
+   // read a register from memory with no alignment requirement
+   static vector load(const T * p)
+   {
+      vector v;
+      std::memcpy(&v, p, sizeof(vector));
+      return v;
+   }
+
+   // write a register to memory with no alignment requirement
+   static void store(T * p, const vector & v)
+   {
+      std::memcpy(p, &v, sizeof(vector));
+   }
+
+   // copy one value into every lane
+   static vector broadcast(const T & value)
+   {
+      return vector{} + value;
+   }
+};
+
+/*************************************************
+ * MASK BITS
+ * The number of set bits in a comparison mask. A
+ * lane that matched has all of its bits set.
+ *************************************************/
+template <typename M>
+inline size_t maskBits(const M & mask)
+{
+   unsigned long long words[sizeof(M) / sizeof(unsigned long long)];
+   std::memcpy(words, &mask, sizeof(M));
+   size_t bits = 0;
+   for (size_t i = 0; i < sizeof(M) / sizeof(unsigned long long); i++)
+      bits += __builtin_popcountll(words[i]);
+   return bits;
+}
+
+/*************************************************
+ * MASK ANY
+ * Did any lane of a comparison mask match?
+ *************************************************/
+template <typename M>
+inline bool maskAny(const M & mask)
+{
+   unsigned long long words[sizeof(M) / sizeof(unsigned long long)];
+   std::memcpy(words, &mask, sizeof(M));
+   unsigned long long any = 0;
+   for (size_t i = 0; i < sizeof(M) / sizeof(unsigned long long); i++)
+      any |= words[i];
+   return any != 0;
+}
+
+#endif // CUSTOM_SIMD_WIDTH
+
+/*************************************************
+ * FILL
+ * Assign value to the n elements starting at p
+ *************************************************/
+template <typename T>
+void fill(T * p, size_t n, const T & value)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      typename L::vector v = L::broadcast(value);
+      for (; i < L::whole(n); i += L::count)
+         L::store(p + i, v);
+   }
+#endif
+   for (; i < n; i++)
+      p[i] = value;
+}
+
+/*************************************************
+ * SUM
+ * Add the n elements starting at p. Floating point
+ * sums are accumulated lane by lane, so rounding may
+ * differ slightly from a left-to-right loop.
+ *************************************************/
+template <typename T>
+T sum(const T * p, size_t n)
+{
+   T total = T();
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      typename L::vector acc = {};
+      for (; i < L::whole(n); i += L::count)
+         acc += L::load(p + i);
+      for (size_t l = 0; l < L::count; l++)
+         total += acc[l];
+   }
+#endif
+   for (; i < n; i++)
+      total += p[i];
+   return total;
+}
+
+/*************************************************
+ * MIN
+ * The smallest of the n elements starting at p.
+ * There must be at least one element.
+ *************************************************/
+template <typename T>
+T min(const T * p, size_t n)
+{
+   T smallest = p[0];
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      if (n >= L::count)
+      {
+         typename L::vector acc = L::load(p);
+         for (i = L::count; i < L::whole(n); i += L::count)
+         {
+            typename L::vector v = L::load(p + i);
+            acc = v < acc ? v : acc;
+         }
+         for (size_t l = 0; l < L::count; l++)
+            if (acc[l] < smallest)
+               smallest = acc[l];
+      }
+   }
+#endif
+   for (; i < n; i++)
+      if (p[i] < smallest)
+         smallest = p[i];
+   return smallest;
+}
+
+/*************************************************
+ * MAX
+ * The largest of the n elements starting at p.
+ * There must be at least one element.
+ *************************************************/
+template <typename T>
+T max(const T * p, size_t n)
+{
+   T largest = p[0];
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      if (n >= L::count)
+      {
+         typename L::vector acc = L::load(p);
+         for (i = L::count; i < L::whole(n); i += L::count)
+         {
+            typename L::vector v = L::load(p + i);
+            acc = acc < v ? v : acc;
+         }
+         for (size_t l = 0; l < L::count; l++)
+            if (largest < acc[l])
+               largest = acc[l];
+      }
+   }
+#endif
+   for (; i < n; i++)
+      if (largest < p[i])
+         largest = p[i];
+   return largest;
+}
+
+/*************************************************
+ * FIND
+ * The index of the first of the n elements starting
+ * at p that equals value, or n if there is none
+ *************************************************/
+template <typename T>
+size_t find(const T * p, size_t n, const T & value)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      typename L::vector key = L::broadcast(value);
+      for (; i < L::whole(n); i += L::count)
+      {
+         typename L::vector v = L::load(p + i);
+         if (maskAny(v == key))
+            for (size_t l = 0; l < L::count; l++)
+               if (v[l] == value)
+                  return i + l;
+      }
+   }
+#endif
+   for (; i < n; i++)
+      if (p[i] == value)
+         return i;
+   return n;
+}
+
+/*************************************************
+ * COUNT
+ * The number of the n elements starting at p that
+ * equal value
+ *************************************************/
+template <typename T>
+size_t count(const T * p, size_t n, const T & value)
+{
+   size_t matches = 0;
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      typename L::vector key = L::broadcast(value);
+      size_t bits = 0;
+      for (; i < L::whole(n); i += L::count)
+         bits += maskBits(L::load(p + i) == key);
+      matches = bits / (sizeof(T) * 8);
+   }
+#endif
+   for (; i < n; i++)
+      if (p[i] == value)
+         matches++;
+   return matches;
+}
+
+/*************************************************
+ * COUNT LESS
+ * The number of the n elements starting at p that
+ * are less than value. Over sorted elements this is
+ * the index of the lower bound.
+ *************************************************/
+template <typename T>
+size_t count_less(const T * p, size_t n, const T & value)
+{
+   size_t matches = 0;
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      typename L::vector key = L::broadcast(value);
+      size_t bits = 0;
+      for (; i < L::whole(n); i += L::count)
+         bits += maskBits(L::load(p + i) < key);
+      matches = bits / (sizeof(T) * 8);
+   }
+#endif
+   for (; i < n; i++)
+      matches += (p[i] < value) ? 1 : 0;
+   return matches;
+}
+
+/*************************************************
+ * COUNT LESS EQUAL
+ * The number of the n elements starting at p that
+ * value is not less than. Over sorted elements this
+ * is the index of the upper bound.
+ *************************************************/
+template <typename T>
+size_t count_less_equal(const T * p, size_t n, const T & value)
+{
+   size_t matches = 0;
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      typename L::vector key = L::broadcast(value);
+      size_t bits = 0;
+      for (; i < L::whole(n); i += L::count)
+         bits += maskBits(L::load(p + i) <= key);
+      matches = bits / (sizeof(T) * 8);
+   }
+#endif
+   for (; i < n; i++)
+      matches += (value < p[i]) ? 0 : 1;
+   return matches;
+}
+
+/*************************************************
+ * ADD
+ * result[i] = lhs[i] + rhs[i] for n elements
+ *************************************************/
+template <typename T>
+void add(const T * lhs, const T * rhs, T * result, size_t n)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      for (; i < L::whole(n); i += L::count)
+         L::store(result + i, L::load(lhs + i) + L::load(rhs + i));
+   }
+#endif
+   for (; i < n; i++)
+      result[i] = lhs[i] + rhs[i];
+}
+
+/*************************************************
+ * MULTIPLY
+ * result[i] = lhs[i] * rhs[i] for n elements
+ *************************************************/
+template <typename T>
+void multiply(const T * lhs, const T * rhs, T * result, size_t n)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      for (; i < L::whole(n); i += L::count)
+         L::store(result + i, L::load(lhs + i) * L::load(rhs + i));
+   }
+#endif
+   for (; i < n; i++)
+      result[i] = lhs[i] * rhs[i];
+}
+
+/*************************************************
+ * BIT AND
+ * result[i] = lhs[i] & rhs[i] for n integers
+ *************************************************/
+template <typename T>
+void bit_and(const T * lhs, const T * rhs, T * result, size_t n)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value && std::is_integral<T>::value)
+   {
+      typedef lane<T> L;
+      for (; i < L::whole(n); i += L::count)
+         L::store(result + i, L::load(lhs + i) & L::load(rhs + i));
+   }
+#endif
+   for (; i < n; i++)
+      result[i] = lhs[i] & rhs[i];
+}
+
+/*************************************************
+ * BIT OR
+ * result[i] = lhs[i] | rhs[i] for n integers
+ *************************************************/
+template <typename T>
+void bit_or(const T * lhs, const T * rhs, T * result, size_t n)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value && std::is_integral<T>::value)
+   {
+      typedef lane<T> L;
+      for (; i < L::whole(n); i += L::count)
+         L::store(result + i, L::load(lhs + i) | L::load(rhs + i));
+   }
+#endif
+   for (; i < n; i++)
+      result[i] = lhs[i] | rhs[i];
+}
+
+/*************************************************
+ * BIT XOR
+ * result[i] = lhs[i] ^ rhs[i] for n integers
+ *************************************************/
+template <typename T>
+void bit_xor(const T * lhs, const T * rhs, T * result, size_t n)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value && std::is_integral<T>::value)
+   {
+      typedef lane<T> L;
+      for (; i < L::whole(n); i += L::count)
+         L::store(result + i, L::load(lhs + i) ^ L::load(rhs + i));
+   }
+#endif
+   for (; i < n; i++)
+      result[i] = lhs[i] ^ rhs[i];
+}
+
+/*************************************************
+ * EQUAL
+ * Are the n elements starting at lhs the same as
+ * the n elements starting at rhs?
+ *************************************************/
+template <typename T>
+bool equal(const T * lhs, const T * rhs, size_t n)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value)
+   {
+      typedef lane<T> L;
+      for (; i < L::whole(n); i += L::count)
+         if (maskAny(L::load(lhs + i) != L::load(rhs + i)))
+            return false;
+   }
+#endif
+   for (; i < n; i++)
+      if (!(lhs[i] == rhs[i]))
+         return false;
+   return true;
+}
+
+/*************************************************
+ * HAS ALL BITS
+ * Is every bit set in the n integers at mask also
+ * set in the n integers at bits? The misses are
+ * OR-ed together and tested once at the end, so
+ * a 64-byte block is one test with AVX-512.
+ *************************************************/
+template <typename T>
+bool has_all_bits(const T * bits, const T * mask, size_t n)
+{
+   size_t i = 0;
+#if CUSTOM_SIMD_WIDTH
+   if constexpr (isVectorizable<T>::value && std::is_integral<T>::value)
+   {
+      typedef lane<T> L;
+      typename L::vector missing = {};
+      for (; i < L::whole(n); i += L::count)
+         missing |= L::load(mask + i) & ~L::load(bits + i);
+      if (maskAny(missing))
+         return false;
+   }
+#endif
+   T missing = T();
+   for (; i < n; i++)
+      missing |= mask[i] & ~bits[i];
+   return missing == T();
+}
+
+/*************************************************
+ * ARRAY OVERLOADS
+ * The same operations over a whole custom::array
+ *************************************************/
+template <typename T, int N>
+void fill(array <T, N> & a, const T & value)
+{
+   fill(a.data(), N, value);
+}
+
+template <typename T, int N>
+T sum(const array <T, N> & a)
+{
+   return sum(a.data(), N);
+}
+
+template <typename T, int N>
+T min(const array <T, N> & a)
+{
+   static_assert(N > 0, "min of an empty array");
+   return min(a.data(), N);
+}
+
+template <typename T, int N>
+T max(const array <T, N> & a)
+{
+   static_assert(N > 0, "max of an empty array");
+   return max(a.data(), N);
+}
+
+template <typename T, int N>
+size_t find(const array <T, N> & a, const T & value)
+{
+   return find(a.data(), N, value);
+}
+
+template <typename T, int N>
+size_t count(const array <T, N> & a, const T & value)
+{
+   return count(a.data(), N, value);
+}
+
+template <typename T, int N>
+size_t count_less(const array <T, N> & a, const T & value)
+{
+   return count_less(a.data(), N, value);
+}
+
+template <typename T, int N>
+size_t count_less_equal(const array <T, N> & a, const T & value)
+{
+   return count_less_equal(a.data(), N, value);
+}
+
+template <typename T, int N>
+void add(const array <T, N> & lhs, const array <T, N> & rhs, array <T, N> & result)
+{
+   add(lhs.data(), rhs.data(), result.data(), N);
+}
+
+template <typename T, int N>
+void multiply(const array <T, N> & lhs, const array <T, N> & rhs, array <T, N> & result)
+{
+   multiply(lhs.data(), rhs.data(), result.data(), N);
+}
+
+template <typename T, int N>
+void bit_and(const array <T, N> & lhs, const array <T, N> & rhs, array <T, N> & result)
+{
+   bit_and(lhs.data(), rhs.data(), result.data(), N);
+}
+
+template <typename T, int N>
+void bit_or(const array <T, N> & lhs, const array <T, N> & rhs, array <T, N> & result)
+{
+   bit_or(lhs.data(), rhs.data(), result.data(), N);
+}
+
+template <typename T, int N>
+void bit_xor(const array <T, N> & lhs, const array <T, N> & rhs, array <T, N> & result)
+{
+   bit_xor(lhs.data(), rhs.data(), result.data(), N);
+}
+
+template <typename T, int N>
+bool equal(const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   return equal(lhs.data(), rhs.data(), N);
+}
+
+template <typename T, int N>
+bool has_all_bits(const array <T, N> & bits, const array <T, N> & mask)
+{
+   return has_all_bits(bits.data(), mask.data(), N);
+}
+
+} // namespace simd
+} // namespace custom
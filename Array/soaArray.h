@@ -0,0 +1,365 @@
+/***********************************************************************
+ * Header:
+ *    SoA Array
+ * Summary:
+ *    A fixed-size structure-of-arrays built from custom::array
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       soa_array              : N records of Fields..., one array per field
+ *       soa_array :: reference : a proxy that looks like one record
+ *       soa_array :: iterator  : an iterator through the records
+ *
+ *    Element i of every field forms record i. A loop that only
+ *    needs one field walks one contiguous array (see field<I>()),
+ *    so every byte brought into the cache is used, and the simd
+ *    bulk operations can run over it directly.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t and std::ptrdiff_t
+#include <iterator>     // for std::random_access_iterator_tag
+#include <stdexcept>    // for std::out_of_range
+#include <tuple>        // for std::tuple
+#include <type_traits>  // for std::conditional
+#include <utility>      // for std::index_sequence
+#include "array.h"
+
+class TestSoaArray; // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * SOA ARRAY
+ * N records, each made of one value of every type
+ * in Fields, stored one custom::array per field
+ ***********************************************/
+template <int N, typename ... Fields>
+class soa_array
+{
+   friend class ::TestSoaArray; // give unit tests access to the privates
+public:
+   // A whole record, copied out of the soa_array
+   typedef std::tuple<Fields...> value_type;
+
+   // The type of field I
+   template <size_t I>
+   using field_type = typename std::tuple_element<I, value_type>::type;
+
+   // Forward declaration for the proxy and iterator classes
+   template <typename S>
+   class basic_reference;
+   template <typename S>
+   class basic_iterator;
+   typedef basic_reference <soa_array>       reference;
+   typedef basic_reference <const soa_array> const_reference;
+   typedef basic_iterator <soa_array>        iterator;
+   typedef basic_iterator <const soa_array>  const_iterator;
+
+   //
+   // Iterator
+   //
+
+   // Return an iterator referring to the first record
+   iterator begin()             { return iterator(this, 0);       }
+   const_iterator begin() const { return const_iterator(this, 0); }
+   // Return an iterator referring to the record off the end
+   iterator end()               { return iterator(this, N);       }
+   const_iterator end() const   { return const_iterator(this, N); }
+
+   //
+   // Access
+   //
+
+   // Field
+   // Return every value of field I as one contiguous array
+   template <size_t I>
+   array <field_type<I>, N> & field()
+   {
+      return std::get<I>(fields);
+   }
+   template <size_t I>
+   const array <field_type<I>, N> & field() const
+   {
+      return std::get<I>(fields);
+   }
+
+   // Get
+   // Return field I of record index
+   template <size_t I>
+   field_type<I> & get(size_t index)
+   {
+      return std::get<I>(fields)[index];
+   }
+   template <size_t I>
+   const field_type<I> & get(size_t index) const
+   {
+      return std::get<I>(fields)[index];
+   }
+
+   // Subscript
+   // Return a proxy for record index
+   reference operator [] (size_t index)
+   {
+      return reference(this, index);
+   }
+   const_reference operator [] (size_t index) const
+   {
+      return const_reference(this, index);
+   }
+
+   // At
+   reference at(size_t index)
+   {
+      if (index >= N)
+         throw std::out_of_range("Index out of range.");
+      return reference(this, index);
+   }
+   const_reference at(size_t index) const
+   {
+      if (index >= N)
+         throw std::out_of_range("Index out of range.");
+      return const_reference(this, index);
+   }
+
+   //
+   // Status
+   //
+
+   // Number of records
+   size_t size()  const { return N;      }
+   bool   empty() const { return N == 0; }
+
+   // Number of fields in each record
+   static constexpr size_t num_fields() { return sizeof...(Fields); }
+
+private:
+   // one array per field
+   std::tuple<array <Fields, N>...> fields;
+};
+
+/**************************************************
+ * SOA ARRAY REFERENCE
+ * A proxy for one record. Assigning to it writes
+ * every field; converting it reads every field.
+ * S is soa_array or const soa_array.
+ *************************************************/
+template <int N, typename ... Fields>
+template <typename S>
+class soa_array <N, Fields...> :: basic_reference
+{
+   friend class ::TestSoaArray; // give unit tests access to the privates
+   template <typename R>
+   friend class basic_reference;
+public:
+   // Refer to record index of pSoa
+   basic_reference(S * pSoa, size_t index) : pSoa(pSoa), index(index)
+   {
+   }
+
+   // Copy a reference to a non-const record into a const one
+   basic_reference(const basic_reference <soa_array> & rhs) :
+      pSoa(rhs.pSoa), index(rhs.index)
+   {
+   }
+
+   // Field I of this record
+   template <size_t I>
+   auto & get() const
+   {
+      return pSoa->template get<I>(index);
+   }
+
+   // Read the whole record
+   operator value_type () const
+   {
+      return read(std::index_sequence_for<Fields...>());
+   }
+
+   // Write the whole record
+   const basic_reference & operator = (const value_type & rhs) const
+   {
+      write(rhs, std::index_sequence_for<Fields...>());
+      return *this;
+   }
+
+   // Copy the values of another record, not the reference itself
+   const basic_reference & operator = (const basic_reference & rhs) const
+   {
+      write(value_type(rhs), std::index_sequence_for<Fields...>());
+      return *this;
+   }
+   basic_reference & operator = (const basic_reference & rhs)
+   {
+      write(value_type(rhs), std::index_sequence_for<Fields...>());
+      return *this;
+   }
+
+   // Compare the values of two records
+   bool operator == (const value_type & rhs) const
+   {
+      return value_type(*this) == rhs;
+   }
+   bool operator != (const value_type & rhs) const
+   {
+      return !(*this == rhs);
+   }
+
+private:
+   template <size_t ... I>
+   value_type read(std::index_sequence<I...>) const
+   {
+      return value_type(get<I>()...);
+   }
+
+   template <size_t ... I>
+   void write(const value_type & rhs, std::index_sequence<I...>) const
+   {
+      // assign field by field, left to right
+      int unused[] = { 0, ((void)(get<I>() = std::get<I>(rhs)), 0)... };
+      (void)unused;
+   }
+
+   S * pSoa;      // the soa_array holding the record
+   size_t index;  // which record
+};
+
+/**************************************************
+ * SOA ARRAY ITERATOR
+ * An iterator through the records. Dereferencing
+ * gives a proxy reference, like std::vector<bool>.
+ *************************************************/
+template <int N, typename ... Fields>
+template <typename S>
+class soa_array <N, Fields...> :: basic_iterator
+{
+   friend class ::TestSoaArray; // give unit tests access to the privates
+   template <typename R>
+   friend class basic_iterator;
+public:
+   typedef std::random_access_iterator_tag iterator_category;
+   typedef typename soa_array::value_type  value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef basic_reference <S>             reference;
+   typedef void                            pointer;
+
+   // Constructors
+   basic_iterator() : pSoa(nullptr), index(0)
+   {
+   }
+   basic_iterator(S * pSoa, size_t index) : pSoa(pSoa), index(index)
+   {
+   }
+
+   // Copy an iterator through non-const records into a const one
+   basic_iterator(const basic_iterator <soa_array> & rhs) :
+      pSoa(rhs.pSoa), index(rhs.index)
+   {
+   }
+
+   // Equals, not equals operator
+   bool operator == (const basic_iterator & rhs) const
+   {
+      return pSoa == rhs.pSoa && index == rhs.index;
+   }
+   bool operator != (const basic_iterator & rhs) const
+   {
+      return !(*this == rhs);
+   }
+
+   // Ordering, by position in the same soa_array
+   bool operator < (const basic_iterator & rhs) const
+   {
+      return index < rhs.index;
+   }
+   bool operator > (const basic_iterator & rhs) const
+   {
+      return rhs < *this;
+   }
+   bool operator <= (const basic_iterator & rhs) const
+   {
+      return !(rhs < *this);
+   }
+   bool operator >= (const basic_iterator & rhs) const
+   {
+      return !(*this < rhs);
+   }
+
+   // Dereference operator
+   // Fetch a proxy for the record
+   reference operator * () const
+   {
+      return reference(pSoa, index);
+   }
+   reference operator [] (difference_type offset) const
+   {
+      return reference(pSoa, index + offset);
+   }
+
+   // Increment and decrement
+   basic_iterator & operator ++ ()
+   {
+      ++index;
+      return *this;
+   }
+   basic_iterator operator ++ (int postfix)
+   {
+      basic_iterator temp = *this;
+      ++index;
+      return temp;
+   }
+   basic_iterator & operator -- ()
+   {
+      --index;
+      return *this;
+   }
+   basic_iterator operator -- (int postfix)
+   {
+      basic_iterator temp = *this;
+      --index;
+      return temp;
+   }
+
+   // Move several records at once
+   basic_iterator & operator += (difference_type offset)
+   {
+      index += offset;
+      return *this;
+   }
+   basic_iterator & operator -= (difference_type offset)
+   {
+      index -= offset;
+      return *this;
+   }
+   basic_iterator operator + (difference_type offset) const
+   {
+      return basic_iterator(pSoa, index + offset);
+   }
+   friend basic_iterator operator + (difference_type offset, const basic_iterator & rhs)
+   {
+      return rhs + offset;
+   }
+   basic_iterator operator - (difference_type offset) const
+   {
+      return basic_iterator(pSoa, index - offset);
+   }
+   difference_type operator - (const basic_iterator & rhs) const
+   {
+      return (difference_type)index - (difference_type)rhs.index;
+   }
+
+private:
+   S * pSoa;      // the soa_array being walked
+   size_t index;  // the current record
+};
+
+}; // namespace custom
@@ -0,0 +1,235 @@
+/***********************************************************************
+ * Header:
+ *    SPSC Ring
+ * Summary:
+ *    A lock-free single-producer, single-consumer ring buffer
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       spsc_ring : a bounded queue between exactly two threads
+ *
+ *    One thread may only push and one other thread may only pop.
+ *    Each index lives on its own cache line together with the
+ *    owner's cached copy of the other index, so the two threads only
+ *    touch each other's line when the ring looks full or empty.
+ *    The batch calls publish many elements with one atomic store.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>          // for std::atomic
+#include <cstddef>         // for size_t
+#include <utility>         // for std::move
+#include "alignedArray.h"  // for aligned_array and cache_line_size
+
+class TestSpscRing; // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * SPSC RING
+ * Up to N elements passed from one producer thread
+ * to one consumer thread with no locks and no
+ * allocation. N must be a power of two.
+ ***********************************************/
+template <typename T, int N>
+class spsc_ring
+{
+   friend class ::TestSpscRing; // give unit tests access to the privates
+
+   static_assert(N > 0 && (N & (N - 1)) == 0,
+                 "spsc_ring capacity must be a power of two");
+public:
+   //
+   // Construct
+   //
+
+   spsc_ring() : head(0), cachedTail(0), tail(0), cachedHead(0), buffer() { }
+   spsc_ring(const spsc_ring & rhs) = delete;
+   spsc_ring & operator = (const spsc_ring & rhs) = delete;
+
+   //
+   // Producer
+   //
+
+   bool try_push(const T &  t);
+   bool try_push(      T && t);
+   size_t try_push_n(const T * items, size_t count);
+
+   //
+   // Consumer
+   //
+
+   bool try_pop(T & t);
+   size_t try_pop_n(T * items, size_t count);
+
+   //
+   // Status
+   //
+
+   // These are only a snapshot when the other thread is running.
+   // head is read first: tail can only have grown since, so the
+   // difference never wraps, though it can pass N if both threads
+   // moved in between.
+   size_t size() const
+   {
+      size_t headIndex = head.load(std::memory_order_acquire);
+      size_t tailIndex = tail.load(std::memory_order_acquire);
+      size_t num = tailIndex - headIndex;
+      return num < N ? num : N;
+   }
+   bool   empty()    const { return size() == 0; }
+   size_t capacity() const { return N;           }
+
+private:
+   static const size_t mask = N - 1;
+
+   // the number of free slots the producer can fill from tail
+   size_t roomFor(size_t tailIndex, size_t count);
+
+   // the number of full slots the consumer can take from head
+   size_t readyFor(size_t headIndex, size_t count);
+
+   // consumer's cache line: written only by the consumer
+   alignas(cache_line_size) std::atomic<size_t> head; // next slot to pop
+   size_t cachedTail;                                  // last tail we saw
+
+   // producer's cache line: written only by the producer
+   alignas(cache_line_size) std::atomic<size_t> tail; // next slot to push
+   size_t cachedHead;                                  // last head we saw
+
+   // the elements, starting on their own cache line
+   aligned_array <T, N> buffer;
+};
+
+/*********************************************
+ * SPSC RING :: ROOM FOR
+ * How many of count elements fit? Only look at the
+ * consumer's index when our cached copy says full.
+ *********************************************/
+template <typename T, int N>
+size_t spsc_ring <T, N> :: roomFor(size_t tailIndex, size_t count)
+{
+   size_t room = N - (tailIndex - cachedHead);
+   if (room < count)
+   {
+      cachedHead = head.load(std::memory_order_acquire);
+      room = N - (tailIndex - cachedHead);
+   }
+   return room < count ? room : count;
+}
+
+/*********************************************
+ * SPSC RING :: READY FOR
+ * How many of count elements can be taken? Only
+ * look at the producer's index when our cached
+ * copy says empty.
+ *********************************************/
+template <typename T, int N>
+size_t spsc_ring <T, N> :: readyFor(size_t headIndex, size_t count)
+{
+   size_t ready = cachedTail - headIndex;
+   if (ready < count)
+   {
+      cachedTail = tail.load(std::memory_order_acquire);
+      ready = cachedTail - headIndex;
+   }
+   return ready < count ? ready : count;
+}
+
+/*********************************************
+ * SPSC RING :: TRY PUSH
+ * Add one element if there is room
+ *    INPUT  : the element to add
+ *    OUTPUT : false if the ring was full
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, int N>
+bool spsc_ring <T, N> :: try_push(const T & t)
+{
+   size_t tailIndex = tail.load(std::memory_order_relaxed);
+   if (roomFor(tailIndex, 1) == 0)
+      return false;
+   buffer[tailIndex & mask] = t;
+   tail.store(tailIndex + 1, std::memory_order_release);
+   return true;
+}
+
+template <typename T, int N>
+bool spsc_ring <T, N> :: try_push(T && t)
+{
+   size_t tailIndex = tail.load(std::memory_order_relaxed);
+   if (roomFor(tailIndex, 1) == 0)
+      return false;
+   buffer[tailIndex & mask] = std::move(t);
+   tail.store(tailIndex + 1, std::memory_order_release);
+   return true;
+}
+
+/*********************************************
+ * SPSC RING :: TRY PUSH N
+ * Add as many of the count items as fit, then
+ * publish them all with one store
+ *    INPUT  : the items and how many there are
+ *    OUTPUT : how many were added
+ *    COST   : O(count)
+ *********************************************/
+template <typename T, int N>
+size_t spsc_ring <T, N> :: try_push_n(const T * items, size_t count)
+{
+   size_t tailIndex = tail.load(std::memory_order_relaxed);
+   size_t num = roomFor(tailIndex, count);
+   for (size_t i = 0; i < num; i++)
+      buffer[(tailIndex + i) & mask] = items[i];
+   if (num)
+      tail.store(tailIndex + num, std::memory_order_release);
+   return num;
+}
+
+/*********************************************
+ * SPSC RING :: TRY POP
+ * Take the oldest element if there is one
+ *    INPUT  : where to put the element
+ *    OUTPUT : false if the ring was empty
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, int N>
+bool spsc_ring <T, N> :: try_pop(T & t)
+{
+   size_t headIndex = head.load(std::memory_order_relaxed);
+   if (readyFor(headIndex, 1) == 0)
+      return false;
+   t = std::move(buffer[headIndex & mask]);
+   head.store(headIndex + 1, std::memory_order_release);
+   return true;
+}
+
+/*********************************************
+ * SPSC RING :: TRY POP N
+ * Take up to count of the oldest elements, then
+ * release their slots with one store
+ *    INPUT  : where to put them and how many we want
+ *    OUTPUT : how many were taken
+ *    COST   : O(count)
+ *********************************************/
+template <typename T, int N>
+size_t spsc_ring <T, N> :: try_pop_n(T * items, size_t count)
+{
+   size_t headIndex = head.load(std::memory_order_relaxed);
+   size_t num = readyFor(headIndex, count);
+   for (size_t i = 0; i < num; i++)
+      items[i] = std::move(buffer[(headIndex + i) & mask]);
+   if (num)
+      head.store(headIndex + num, std::memory_order_release);
+   return num;
+}
+
+}; // namespace custom
@@ -0,0 +1,263 @@
+/***********************************************************************
+ * Header:
+ *    Static Map
+ * Summary:
+ *    A read-only map whose collision-free hash table is built by the
+ *    compiler from a custom::array of key/value pairs
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       static_hash     : a seeded hash for integers and string_views
+ *       static_map      : N keys, each in its own slot
+ *       make_static_map : build a static_map, deducing the types
+ *
+ *    The table is built with "hash and displace": the keys are
+ *    split into buckets by one hash, and each bucket, biggest first,
+ *    is given the first seed that sends all of its keys to empty
+ *    slots. A lookup is then two hashes, one probe and one compare:
+ *
+ *       constexpr custom::array<std::pair<std::string_view, int>, 3> items =
+ *          {{ { "GET", 1 }, { "PUT", 2 }, { "POST", 3 } }};
+ *       constexpr auto methods = custom::make_static_map(items);
+ *       static_assert(*methods.find("PUT") == 2, "");
+ *
+ *    Key and Value must be default constructible and assignable in a
+ *    constant expression: integers, enums, pointers, string_views.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <stdexcept>    // for std::out_of_range and std::invalid_argument
+#include <string_view>  // for std::string_view
+#include <type_traits>  // for std::is_integral and std::is_enum
+#include <utility>      // for std::pair
+#include "array.h"
+
+class TestStaticMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************
+ * MIX
+ * Spread the bits of x over the whole word
+ * (the splitmix64 finalizer)
+ ****************************************************/
+constexpr uint64_t mix(uint64_t x)
+{
+   x ^= x >> 30;
+   x *= 0xbf58476d1ce4e5b9ULL;
+   x ^= x >> 27;
+   x *= 0x94d049bb133111ebULL;
+   x ^= x >> 31;
+   return x;
+}
+
+/*****************************************************
+ * STATIC HASH
+ * A different hash function for every seed, usable
+ * in a constant expression
+ ****************************************************/
+template <typename Key>
+struct static_hash
+{
+   static_assert(std::is_integral<Key>::value || std::is_enum<Key>::value,
+                 "static_hash needs an integer, enum or string_view key");
+
+   constexpr uint64_t operator () (const Key & key, uint64_t seed) const
+   {
+      return mix((uint64_t)key ^ (seed * 0x9e3779b97f4a7c15ULL));
+   }
+};
+
+template <>
+struct static_hash <std::string_view>
+{
+   // FNV-1a over the characters, starting from the seed
+   constexpr uint64_t operator () (std::string_view key, uint64_t seed) const
+   {
+      uint64_t hash = 0xcbf29ce484222325ULL ^ mix(seed);
+      for (char c : key)
+      {
+         hash ^= (unsigned char)c;
+         hash *= 0x100000001b3ULL;
+      }
+      return mix(hash);
+   }
+};
+
+/************************************************
+ * STATIC MAP
+ * N unique keys, each with a value, laid out by the
+ * compiler so that every key has its own slot
+ ***********************************************/
+template <typename Key, typename Value, int N, typename Hash = static_hash<Key> >
+class static_map
+{
+   friend class ::TestStaticMap; // give unit tests access to the privates
+
+   static_assert(N > 0, "static_map needs at least one key");
+public:
+   typedef Key   key_type;
+   typedef Value mapped_type;
+   typedef std::pair<Key, Value> value_type;
+
+   // The number of slots, at most twice the number of keys
+   static const int table_size = next_power_of_two(N);
+
+   //
+   // Construct
+   //
+
+   constexpr static_map(const array <value_type, N> & items);
+
+   //
+   // Lookup
+   //
+
+   // Return the value for key, or nullptr if key is not in the map
+   constexpr const Value * find(const Key & key) const
+   {
+      size_t slot = slotFor(key);
+      return holds(slot, key) ? &values[slot] : nullptr;
+   }
+   constexpr bool contains(const Key & key) const
+   {
+      return holds(slotFor(key), key);
+   }
+   constexpr size_t count(const Key & key) const
+   {
+      return contains(key) ? 1 : 0;
+   }
+   constexpr const Value & at(const Key & key) const
+   {
+      size_t slot = slotFor(key);
+      if (!holds(slot, key))
+         throw std::out_of_range("Key not found.");
+      return values[slot];
+   }
+
+   //
+   // Status
+   //
+
+   constexpr size_t size()  const { return N;     }
+   constexpr bool   empty() const { return false; }
+
+private:
+   static const size_t mask = table_size - 1;
+
+   // the first hash picks the bucket
+   static constexpr size_t bucketFor(const Key & key)
+   {
+      return Hash()(key, 0) & mask;
+   }
+
+   // the bucket's seed picks the slot
+   constexpr size_t slotFor(const Key & key) const
+   {
+      return Hash()(key, seeds[bucketFor(key)]) & mask;
+   }
+
+   // is key the one in slot?
+   constexpr bool holds(size_t slot, const Key & key) const
+   {
+      return used[slot] && keys[slot] == key;
+   }
+
+   array <Key,      table_size> keys;    // the key in each slot
+   array <Value,    table_size> values;  // the value in each slot
+   array <bool,     table_size> used;    // does the slot hold a key?
+   array <uint64_t, table_size> seeds;   // the seed for each bucket
+};
+
+/*********************************************
+ * STATIC MAP :: CONSTRUCTOR
+ * Find a seed for every bucket so that no two keys
+ * share a slot. Done in a constant expression, a
+ * duplicate key is a compile error.
+ *    INPUT  : the key/value pairs
+ *    COST   : about O(N^2), paid by the compiler
+ *********************************************/
+template <typename Key, typename Value, int N, typename Hash>
+constexpr static_map <Key, Value, N, Hash> ::
+static_map(const array <value_type, N> & items) :
+   keys(), values(), used(), seeds()
+{
+   // which bucket each key falls in, and how big each bucket is
+   array <size_t, N> bucketOf{};
+   array <int, table_size> bucketSize{};
+   int largest = 0;
+   for (int i = 0; i < N; i++)
+   {
+      for (int j = 0; j < i; j++)
+         if (items[j].first == items[i].first)
+            throw std::invalid_argument("Duplicate key in static_map.");
+      bucketOf[i] = bucketFor(items[i].first);
+      if (++bucketSize[bucketOf[i]] > largest)
+         largest = bucketSize[bucketOf[i]];
+   }
+
+   // place the biggest buckets first while the table is still empty
+   array <int, N> members{};
+   array <size_t, N> slots{};
+   for (int size = largest; size > 0; size--)
+      for (size_t bucket = 0; bucket < (size_t)table_size; bucket++)
+      {
+         if (bucketSize[bucket] != size)
+            continue;
+
+         int numMembers = 0;
+         for (int i = 0; i < N; i++)
+            if (bucketOf[i] == bucket)
+               members[numMembers++] = i;
+
+         // try seeds until every member lands in its own empty slot
+         for (uint64_t seed = 1; ; seed++)
+         {
+            if (seed > 1000000)
+               throw std::logic_error("No perfect hash found for static_map.");
+
+            bool fits = true;
+            for (int m = 0; fits && m < numMembers; m++)
+            {
+               slots[m] = Hash()(items[members[m]].first, seed) & mask;
+               fits = !used[slots[m]];
+               for (int k = 0; fits && k < m; k++)
+                  fits = slots[k] != slots[m];
+            }
+            if (!fits)
+               continue;
+
+            seeds[bucket] = seed;
+            for (int m = 0; m < numMembers; m++)
+            {
+               used[slots[m]]   = true;
+               keys[slots[m]]   = items[members[m]].first;
+               values[slots[m]] = items[members[m]].second;
+            }
+            break;
+         }
+      }
+}
+
+/*****************************************************
+ * MAKE STATIC MAP
+ * Build a static_map, deducing the key, value and size
+ ****************************************************/
+template <typename Key, typename Value, int N>
+constexpr static_map <Key, Value, N> make_static_map(const array <std::pair<Key, Value>, N> & items)
+{
+   return static_map <Key, Value, N>(items);
+}
+
+}; // namespace custom
@@ -0,0 +1,488 @@
+/***********************************************************************
+ * Header:
+ *    Static Vector
+ * Summary:
+ *    A vector with a fixed capacity whose elements live inside the
+ *    object itself, so it never touches the heap
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       static_vector             : up to N elements, like std::vector
+ *       static_vector :: iterator : the same iterator as custom::array
+ *
+ *    The storage is a custom::array of raw, uninitialized slots.
+ *    Only the first size() slots hold a constructed T.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>           // because I am paranoid
+#include <cstddef>           // for size_t
+#include <initializer_list>  // for std::initializer_list
+#include <new>               // for placement new and std::launder
+#include <stdexcept>         // for std::out_of_range and std::length_error
+#include <type_traits>       // for std::enable_if
+#include <utility>           // for std::move and std::forward
+#include "array.h"
+
+class TestStaticVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * STATIC VECTOR
+ * A vector that can hold up to N elements without
+ * allocating. Elements are constructed only when
+ * they are added and destroyed when removed.
+ ***********************************************/
+template <typename T, int N>
+class static_vector
+{
+   friend class ::TestStaticVector; // give unit tests access to the privates
+public:
+   typedef T value_type;
+   typedef typename array <T, N> :: iterator       iterator;
+   typedef typename array <T, N> :: const_iterator const_iterator;
+
+   //
+   // Construct
+   //
+
+   static_vector() : numElements(0) { }
+   static_vector(size_t num);
+   static_vector(size_t num, const T & t);
+   static_vector(const std::initializer_list<T> & il);
+   template <class Iterator,
+             class = typename std::enable_if<!std::is_integral<Iterator>::value>::type>
+   static_vector(Iterator first, Iterator last) : numElements(0)
+   {
+      try
+      {
+         for (Iterator it = first; it != last; ++it)
+            push_back(*it);
+      }
+      catch (...)
+      {
+         clear();
+         throw;
+      }
+   }
+   static_vector(const static_vector & rhs);
+   static_vector(static_vector && rhs);
+   ~static_vector()
+   {
+      clear();
+   }
+
+   //
+   // Assign
+   //
+
+   static_vector & operator = (const static_vector & rhs);
+   static_vector & operator = (static_vector && rhs);
+   static_vector & operator = (const std::initializer_list<T> & il);
+   void swap(static_vector & rhs);
+
+   //
+   // Iterator
+   //
+
+   iterator       begin()        { return iterator(ptr(0));                   }
+   const_iterator begin()  const { return const_iterator(ptr(0));             }
+   const_iterator cbegin() const { return const_iterator(ptr(0));             }
+   iterator       end()          { return iterator(ptr(numElements));         }
+   const_iterator end()    const { return const_iterator(ptr(numElements));   }
+   const_iterator cend()   const { return const_iterator(ptr(numElements));   }
+
+   //
+   // Access
+   //
+
+   T & operator [] (size_t index)             { return *ptr(index); }
+   const T & operator [] (size_t index) const { return *ptr(index); }
+   T & at(size_t index)
+   {
+      if (index >= numElements)
+         throw std::out_of_range("Index out of range.");
+      return *ptr(index);
+   }
+   const T & at(size_t index) const
+   {
+      if (index >= numElements)
+         throw std::out_of_range("Index out of range.");
+      return *ptr(index);
+   }
+   T & front()             { return *ptr(0);               }
+   const T & front() const { return *ptr(0);               }
+   T & back()              { return *ptr(numElements - 1); }
+   const T & back()  const { return *ptr(numElements - 1); }
+   T * data()              { return ptr(0);                }
+   const T * data()  const { return ptr(0);                }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T &  t) { emplace_back(t);            }
+   void push_back(      T && t) { emplace_back(std::move(t)); }
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   iterator insert(const_iterator it, const T &  t) { return emplace(it, t);            }
+   iterator insert(const_iterator it,       T && t) { return emplace(it, std::move(t)); }
+   template <class ... Args>
+   iterator emplace(const_iterator it, Args && ... args);
+
+   //
+   // Remove
+   //
+
+   void pop_back();
+   iterator erase(const_iterator it);
+   iterator erase(const_iterator first, const_iterator last);
+   void clear()
+   {
+      while (numElements)
+         pop_back();
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()     const { return numElements;      }
+   size_t capacity() const { return N;                }
+   bool   empty()    const { return numElements == 0; }
+   bool   full()     const { return numElements == N; }
+
+private:
+   // one uninitialized element's worth of bytes
+   struct slot
+   {
+      alignas(T) unsigned char bytes[sizeof(T)];
+   };
+
+   // the element in slot index, constructed or not
+   T * ptr(size_t index)
+   {
+      return std::launder(reinterpret_cast<T *>(storage.data() + index));
+   }
+   const T * ptr(size_t index) const
+   {
+      return std::launder(reinterpret_cast<const T *>(storage.data() + index));
+   }
+
+   // make room for one more element or complain
+   void checkRoom() const
+   {
+      if (numElements == N)
+         throw std::length_error("static_vector is full");
+   }
+
+   array <slot, N> storage;  // raw storage for N elements
+   size_t numElements;       // the number of constructed elements
+};
+
+/*****************************************
+ * STATIC VECTOR :: NON-DEFAULT constructors
+ * Create num default-constructed elements
+ ****************************************/
+template <typename T, int N>
+static_vector <T, N> :: static_vector(size_t num) : numElements(0)
+{
+   try
+   {
+      while (numElements < num)
+         emplace_back();
+   }
+   catch (...)
+   {
+      clear();
+      throw;
+   }
+}
+
+/*****************************************
+ * STATIC VECTOR :: NON-DEFAULT constructors
+ * Create num copies of t
+ ****************************************/
+template <typename T, int N>
+static_vector <T, N> :: static_vector(size_t num, const T & t) : numElements(0)
+{
+   try
+   {
+      while (numElements < num)
+         emplace_back(t);
+   }
+   catch (...)
+   {
+      clear();
+      throw;
+   }
+}
+
+/*****************************************
+ * STATIC VECTOR :: INITIALIZER LIST constructor
+ * Copy the elements of the list
+ ****************************************/
+template <typename T, int N>
+static_vector <T, N> :: static_vector(const std::initializer_list<T> & il) : numElements(0)
+{
+   try
+   {
+      for (const T & t : il)
+         emplace_back(t);
+   }
+   catch (...)
+   {
+      clear();
+      throw;
+   }
+}
+
+/*****************************************
+ * STATIC VECTOR :: COPY constructor
+ * Copy-construct each element of rhs
+ ****************************************/
+template <typename T, int N>
+static_vector <T, N> :: static_vector(const static_vector & rhs) : numElements(0)
+{
+   try
+   {
+      for (size_t i = 0; i < rhs.numElements; i++)
+         emplace_back(rhs[i]);
+   }
+   catch (...)
+   {
+      clear();
+      throw;
+   }
+}
+
+/*****************************************
+ * STATIC VECTOR :: MOVE constructor
+ * There is no buffer to steal, so move each
+ * element and leave rhs empty
+ ****************************************/
+template <typename T, int N>
+static_vector <T, N> :: static_vector(static_vector && rhs) : numElements(0)
+{
+   try
+   {
+      for (size_t i = 0; i < rhs.numElements; i++)
+         emplace_back(std::move(rhs[i]));
+   }
+   catch (...)
+   {
+      clear();
+      throw;
+   }
+   rhs.clear();
+}
+
+/**********************************************
+ * STATIC VECTOR :: assignment operator
+ * Assign over the existing elements, then add
+ * or remove the difference
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, int N>
+static_vector <T, N> & static_vector <T, N> :: operator = (const static_vector & rhs)
+{
+   if (this != &rhs)
+   {
+      size_t i = 0;
+      for (; i < numElements && i < rhs.numElements; i++)
+         (*this)[i] = rhs[i];
+      for (; i < rhs.numElements; i++)
+         emplace_back(rhs[i]);
+      while (numElements > rhs.numElements)
+         pop_back();
+   }
+   return *this;
+}
+
+/**********************************************
+ * STATIC VECTOR :: assignment operator - MOVE
+ * Move-assign over the existing elements, then
+ * add or remove the difference. rhs is left empty.
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, int N>
+static_vector <T, N> & static_vector <T, N> :: operator = (static_vector && rhs)
+{
+   if (this != &rhs)
+   {
+      size_t i = 0;
+      for (; i < numElements && i < rhs.numElements; i++)
+         (*this)[i] = std::move(rhs[i]);
+      for (; i < rhs.numElements; i++)
+         emplace_back(std::move(rhs[i]));
+      while (numElements > rhs.numElements)
+         pop_back();
+      rhs.clear();
+   }
+   return *this;
+}
+
+/**********************************************
+ * STATIC VECTOR :: assignment operator
+ * Copy the elements of an initializer list
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, int N>
+static_vector <T, N> & static_vector <T, N> :: operator = (const std::initializer_list<T> & il)
+{
+   size_t i = 0;
+   auto itIl = il.begin();
+   for (; i < numElements && itIl != il.end(); i++, ++itIl)
+      (*this)[i] = *itIl;
+   for (; itIl != il.end(); ++itIl)
+      emplace_back(*itIl);
+   while (numElements > il.size())
+      pop_back();
+   return *this;
+}
+
+/**********************************************
+ * STATIC VECTOR :: SWAP
+ * Swap the elements both have, then move the
+ * extra elements of the longer one across
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, int N>
+void static_vector <T, N> :: swap(static_vector & rhs)
+{
+   if (this == &rhs)
+      return;
+
+   static_vector & shorter = numElements < rhs.numElements ? *this : rhs;
+   static_vector & longer  = numElements < rhs.numElements ? rhs : *this;
+
+   size_t common = shorter.numElements;
+   for (size_t i = 0; i < common; i++)
+   {
+      using std::swap;
+      swap(shorter[i], longer[i]);
+   }
+   for (size_t i = common; i < longer.numElements; i++)
+      shorter.emplace_back(std::move(longer[i]));
+   while (longer.numElements > common)
+      longer.pop_back();
+}
+
+/*********************************************
+ * STATIC VECTOR :: EMPLACE BACK
+ * Construct a new element at the end in place
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, int N>
+template <class ... Args>
+T & static_vector <T, N> :: emplace_back(Args && ... args)
+{
+   checkRoom();
+   T * p = new (storage.data() + numElements) T(std::forward<Args>(args)...);
+   numElements++;
+   return *p;
+}
+
+/*********************************************
+ * STATIC VECTOR :: EMPLACE
+ * Construct a new element in front of it. The
+ * later elements shift one slot to the right.
+ *    COST   : O(n)
+ *********************************************/
+template <typename T, int N>
+template <class ... Args>
+typename static_vector <T, N> :: iterator
+static_vector <T, N> :: emplace(const_iterator it, Args && ... args)
+{
+   size_t index = it - cbegin();
+   assert(index <= numElements);
+   checkRoom();
+
+   // appending needs no shifting
+   if (index == numElements)
+   {
+      emplace_back(std::forward<Args>(args)...);
+      return begin() + index;
+   }
+
+   // build the new value first in case args refer to an element
+   T t(std::forward<Args>(args)...);
+   emplace_back(std::move(back()));
+   for (size_t i = numElements - 2; i > index; i--)
+      (*this)[i] = std::move((*this)[i - 1]);
+   (*this)[index] = std::move(t);
+   return begin() + index;
+}
+
+/*********************************************
+ * STATIC VECTOR :: POP BACK
+ * Destroy the last element
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, int N>
+void static_vector <T, N> :: pop_back()
+{
+   if (numElements)
+   {
+      ptr(numElements - 1)->~T();
+      numElements--;
+   }
+}
+
+/******************************************
+ * STATIC VECTOR :: ERASE
+ * Remove one element. The later elements shift
+ * one slot to the left.
+ *     OUTPUT : iterator to the element after it
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, int N>
+typename static_vector <T, N> :: iterator
+static_vector <T, N> :: erase(const_iterator it)
+{
+   return erase(it, it + 1);
+}
+
+/******************************************
+ * STATIC VECTOR :: ERASE
+ * Remove the elements in [first, last)
+ *     OUTPUT : iterator to the element after them
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, int N>
+typename static_vector <T, N> :: iterator
+static_vector <T, N> :: erase(const_iterator first, const_iterator last)
+{
+   size_t iFirst = first - cbegin();
+   size_t iLast  = last  - cbegin();
+   assert(iFirst <= iLast && iLast <= numElements);
+
+   size_t removed = iLast - iFirst;
+   for (size_t i = iFirst; i + removed < numElements; i++)
+      (*this)[i] = std::move((*this)[i + removed]);
+   for (size_t i = 0; i < removed; i++)
+      pop_back();
+   return begin() + iFirst;
+}
+
+/**********************************************
+ * SWAP
+ * Exchange the elements of two static vectors
+ *********************************************/
+template <typename T, int N>
+void swap(static_vector <T, N> & lhs, static_vector <T, N> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+}; // namespace custom
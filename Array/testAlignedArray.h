@@ -0,0 +1,167 @@
+/***********************************************************************
+ * Header:
+ *    TEST ALIGNED ARRAY
+ * Summary:
+ *    Unit tests for aligned_array
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <cstdint>         // for uintptr_t
+#include "alignedArray.h"  // class under test
+#include "simd.h"          // the bulk operations work on aligned arrays too
+#include "unitTest.h"      // unit test baseclass
+#include "spy.h"           // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST ALIGNED ARRAY
+ * Unit tests for the aligned_array class
+ ***********************************************/
+class TestAlignedArray : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_layout_cacheLine();
+      test_layout_padded();
+      test_layout_simdWidth();
+      test_layout_neighbors();
+
+      // Access
+      test_alignedData();
+      test_access_inherited();
+      test_access_spy();
+      test_simd_sum();
+
+      report("AlignedArray");
+   }
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // the default is one cache line
+   void test_layout_cacheLine()
+   {  // setup
+      // exercise
+      custom::aligned_array<int, 4> a;
+      // verify
+      assertUnit(alignof(custom::aligned_array<int, 4>) == 64);
+      assertUnit(sizeof(a) == 64);
+      assertUnit(a.is_aligned());
+      assertUnit(address(a.data()) % 64 == 0);
+   }  // teardown
+
+   // the size is rounded up to a whole number of cache lines
+   void test_layout_padded()
+   {  // setup
+      // exercise
+      custom::aligned_array<double, 9> a;
+      // verify
+      assertUnit(sizeof(a) == 128);
+      assertUnit(a.size() == 9);
+      assertUnit(a.is_aligned());
+   }  // teardown
+
+   // a vector register width rather than a cache line
+   void test_layout_simdWidth()
+   {  // setup
+      // exercise
+      custom::aligned_array<float, 3, 16> a;
+      // verify
+      assertUnit(alignof(custom::aligned_array<float, 3, 16>) == 16);
+      assertUnit(sizeof(a) == 16);
+      assertUnit(a.alignment == 16);
+      assertUnit(a.is_aligned());
+   }  // teardown
+
+   // per-core arrays side by side never share a cache line
+   void test_layout_neighbors()
+   {  // setup
+      // exercise
+      custom::aligned_array<long, 2> perCore[4];
+      // verify
+      for (int i = 0; i < 4; i++)
+         assertUnit(perCore[i].is_aligned());
+      assertUnit(address(&perCore[1]) - address(&perCore[0]) == 64);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // aligned_data refers to the same storage as data
+   void test_alignedData()
+   {  // setup
+      custom::aligned_array<int, 16> a;
+      a.fill(3);
+      // exercise
+      int * p = a.aligned_data();
+      // verify
+      assertUnit(p == a.data());
+      assertUnit(address(p) % 64 == 0);
+      assertUnit(p[15] == 3);
+   }  // teardown
+
+   // every array method is still there
+   void test_access_inherited()
+   {  // setup
+      custom::aligned_array<int, 4> a = { 26, 49, 67, 89 };
+      // exercise
+      int total = 0;
+      for (auto it = a.begin(); it != a.end(); ++it)
+         total += *it;
+      // verify
+      assertUnit(total == 26 + 49 + 67 + 89);
+      assertUnit(a.front() == 26);
+      assertUnit(a.back() == 89);
+      assertUnit(a.at(2) == 67);
+      assertUnit(a[1] == 49);
+   }  // teardown
+
+   // no extra copies are made for a class type
+   void test_access_spy()
+   {  // setup
+      Spy::reset();
+      // exercise
+      {
+         custom::aligned_array<Spy, 4> a;
+         a[2] = Spy(67);
+         assertUnit(a[2] == Spy(67));
+         assertUnit(a.is_aligned());
+      }
+      // verify
+      assertUnit(Spy::numDefault() == 4);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 1);
+      assertUnit(Spy::numAlloc() == Spy::numDelete());
+   }  // teardown
+
+   // the bulk operations accept an aligned array
+   void test_simd_sum()
+   {  // setup
+      custom::aligned_array<int, 100> a;
+      custom::simd::fill(a, 2);
+      // exercise
+      int total = custom::simd::sum(a);
+      // verify
+      assertUnit(total == 200);
+   }  // teardown
+
+   // the address of a pointer as a number
+   template <typename P>
+   static uintptr_t address(const P * p)
+   {
+      return reinterpret_cast<uintptr_t>(p);
+   }
+};
+
+#endif // DEBUG
@@ -12,8 +12,24 @@
 #endif
  //#undef DEBUG  // Remove this comment to disable unit tests
 
-#include "testSpy.h"       // for the spy unit tests
-#include "testArray.h"     // for the array unit tests
+#include "testSpy.h"            // for the spy unit tests
+#include "testArray.h"          // for the array unit tests
+#include "testSimd.h"           // for the simd unit tests
+#include "testAlignedArray.h"   // for the aligned array unit tests
+#include "testSoaArray.h"       // for the structure-of-arrays unit tests
+#include "testStaticVector.h"   // for the static vector unit tests
+#include "testSpscRing.h"       // for the ring buffer unit tests
+#include "testBitset.h"         // for the bitset unit tests
+#include "testMdArray.h"        // for the md_array unit tests
+#include "testStaticMap.h"      // for the static_map unit tests
+#include "testMappedArray.h"    // for the mapped_array unit tests
+#include "testSortingNetwork.h" // for the sorting network unit tests
+#include "testSearch.h"         // for the branchless search unit tests
+#include "testFenwick.h"        // for the fenwick unit tests
+#include "testSegmentTree.h"    // for the segment_tree unit tests
+#include "testSeqlockArray.h"   // for the seqlock_array unit tests
+#include "testFixedString.h"    // for the fixed_string unit tests
+#include "testBloomFilter.h"    // for the bloom_filter unit tests
 int Spy::counters[] = {};
 
 
@@ -28,6 +44,22 @@ int main()
    // unit tests
    TestSpy().run();
    TestArray().run();
+   TestSimd().run();
+   TestAlignedArray().run();
+   TestSoaArray().run();
+   TestStaticVector().run();
+   TestSpscRing().run();
+   TestBitset().run();
+   TestMdArray().run();
+   TestStaticMap().run();
+   TestMappedArray().run();
+   TestSortingNetwork().run();
+   TestSearch().run();
+   TestFenwick().run();
+   TestSegmentTree().run();
+   TestSeqlockArray().run();
+   TestFixedString().run();
+   TestBloomFilter().run();
 #endif // DEBUG
    
    return 0;
@@ -12,6 +12,7 @@
 #ifdef DEBUG
 
 #include <array>
+#include <algorithm>    // for std::sort
 #include "array.h"      // class under test
 #include "unitTest.h"   // unit test baseclass
 #include "spy.h"        // spy is a mock class to monitor the class under test
@@ -47,6 +48,31 @@ public:
       test_front_write();
       test_back_read();
       test_back_write();
+
+      // Fill and swap
+      test_fill_standard();
+      test_swap_standard();
+      test_swap_nonmember();
+      test_fill_trivial();
+      test_fill_bytes();
+      test_swap_trivial();
+      test_swap_self();
+
+      // Comparison
+      test_equals_same();
+      test_equals_different();
+      test_equals_trivial();
+      test_lessthan_standard();
+      test_lessthan_equal();
+      test_lessthan_signed();
+      test_lessthan_bytes();
+      test_constexpr_compare();
+
+      // Constant expressions
+      test_constexpr_access();
+      test_constexpr_iterator();
+      test_constexpr_fillSwap();
+      test_constexpr_makeArray();
       
 
       // Iterator
@@ -66,6 +92,26 @@ public:
       test_iterator_dereferenceWrite();
       test_iterator_incrementPrefix();
       test_iterator_incrementPostfix();
+      test_iterator_decrementPrefix();
+      test_iterator_decrementPostfix();
+      test_iterator_plus();
+      test_iterator_minus();
+      test_iterator_difference();
+      test_iterator_subscript();
+      test_iterator_lessthan();
+      test_iterator_traits();
+
+      // Const and reverse iterator
+      test_cbegin();
+      test_beginConst();
+      test_constIterator_fromIterator();
+      test_rbegin_walk();
+      test_crbegin_walk();
+
+      // Standard algorithms
+      test_algorithm_sort();
+      test_algorithm_lowerBound();
+      test_algorithm_copy();
 
       report("Array");
    }
@@ -1004,6 +1050,780 @@ public:
       assertStandardFixture(a);
    }  // teardown
 
+   // Decrement an iterator
+   void test_iterator_decrementPrefix()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //               itRHS
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator itRHS;
+      itRHS.p = &(a.__elems_[2]);
+      custom::array<Spy, 4>::iterator itLHS;
+      Spy::reset();
+      // exercise
+      itLHS = --itRHS;
+      // verify
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //         itRHS
+      //         itLHS
+      assertUnit(&(a.__elems_[1]) == itLHS.p);
+      assertUnit(&(a.__elems_[1]) == itRHS.p);
+      assertStandardFixture(a);
+   }  // teardown
+
+   // Decrement an iterator
+   void test_iterator_decrementPostfix()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //               itRHS
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator itRHS;
+      itRHS.p = &(a.__elems_[2]);
+      custom::array<Spy, 4>::iterator itLHS;
+      Spy::reset();
+      // exercise
+      itLHS = itRHS--;
+      // verify
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //         itRHS
+      //              itLHS
+      assertUnit(&(a.__elems_[2]) == itLHS.p);
+      assertUnit(&(a.__elems_[1]) == itRHS.p);
+      assertStandardFixture(a);
+   }  // teardown
+
+   // Move an iterator forward several elements
+   void test_iterator_plus()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //    it
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator it;
+      it.p = &(a.__elems_[0]);
+      Spy::reset();
+      // exercise
+      custom::array<Spy, 4>::iterator itPlus = it + 3;
+      custom::array<Spy, 4>::iterator itPlusReversed = 2 + it;
+      it += 1;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //         it  itPR  itPlus
+      assertUnit(itPlus.p == &(a.__elems_[3]));
+      assertUnit(itPlusReversed.p == &(a.__elems_[2]));
+      assertUnit(it.p == &(a.__elems_[1]));
+      assertStandardFixture(a);
+   }  // teardown
+
+   // Move an iterator backward several elements
+   void test_iterator_minus()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //                           it
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator it;
+      it.p = &(a.__elems_[4]);
+      Spy::reset();
+      // exercise
+      custom::array<Spy, 4>::iterator itMinus = it - 4;
+      it -= 1;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //    itMinus        it
+      assertUnit(itMinus.p == &(a.__elems_[0]));
+      assertUnit(it.p == &(a.__elems_[3]));
+      assertStandardFixture(a);
+   }  // teardown
+
+   // Distance between two iterators
+   void test_iterator_difference()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //         itLHS          itRHS
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator itLHS;
+      itLHS.p = &(a.__elems_[1]);
+      custom::array<Spy, 4>::iterator itRHS;
+      itRHS.p = &(a.__elems_[4]);
+      // exercise
+      std::ptrdiff_t forward  = itRHS - itLHS;
+      std::ptrdiff_t backward = itLHS - itRHS;
+      // verify
+      assertUnit(forward == 3);
+      assertUnit(backward == -3);
+      assertStandardFixture(a);
+   }  // teardown
+
+   // Subscript relative to an iterator
+   void test_iterator_subscript()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //         it
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator it;
+      it.p = &(a.__elems_[1]);
+      Spy s;
+      Spy::reset();
+      // exercise
+      s = it[2];
+      // verify
+      assertUnit(Spy::numAssign() == 1);    // s = a[3]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(s == Spy(89));
+      assertUnit(it[-1] == Spy(26));
+      assertStandardFixture(a);
+   }  // teardown
+
+   // Order of two iterators
+   void test_iterator_lessthan()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //    itLHS      itRHS
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator itLHS;
+      itLHS.p = &(a.__elems_[0]);
+      custom::array<Spy, 4>::iterator itRHS;
+      itRHS.p = &(a.__elems_[2]);
+      Spy::reset();
+      // exercise and verify
+      assertUnit(itLHS < itRHS);
+      assertUnit(!(itRHS < itLHS));
+      assertUnit(itRHS > itLHS);
+      assertUnit(itLHS <= itLHS);
+      assertUnit(itRHS >= itLHS);
+      assertUnit(Spy::numLessthan() == 0);  // compares pointers, not Spys
+      assertStandardFixture(a);
+   }  // teardown
+
+   // The standard library sees a random-access iterator
+   void test_iterator_traits()
+   {  // setup
+      typedef custom::array<Spy, 4>::iterator Iterator;
+      typedef custom::array<Spy, 4>::const_iterator ConstIterator;
+      // exercise
+      typedef std::iterator_traits<Iterator> Traits;
+      typedef std::iterator_traits<ConstIterator> ConstTraits;
+      // verify
+      static_assert(std::is_same<Traits::iterator_category,
+                                 std::random_access_iterator_tag>::value,
+                    "iterator is not random access");
+      static_assert(std::is_same<Traits::value_type, Spy>::value,
+                    "iterator value_type");
+      static_assert(std::is_same<Traits::reference, Spy &>::value,
+                    "iterator reference");
+      static_assert(std::is_same<ConstTraits::value_type, Spy>::value,
+                    "const_iterator value_type");
+      static_assert(std::is_same<ConstTraits::reference, const Spy &>::value,
+                    "const_iterator reference");
+#ifdef __cpp_lib_concepts
+      static_assert(std::contiguous_iterator<Iterator>,
+                    "iterator is not contiguous");
+      static_assert(std::contiguous_iterator<ConstIterator>,
+                    "const_iterator is not contiguous");
+#endif
+      assertUnit(true);
+   }  // teardown
+
+   // cbegin and cend on the standard fixture
+   void test_cbegin()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      // exercise
+      custom::array<Spy, 4>::const_iterator itBegin = a.cbegin();
+      custom::array<Spy, 4>::const_iterator itEnd = a.cend();
+      // verify
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //    itBegin                itEnd
+      assertUnit(itBegin.p == &(a.__elems_[0]));
+      assertUnit(itEnd.p == &(a.__elems_[4]));
+      assertUnit(itEnd - itBegin == 4);
+      assertStandardFixture(a);
+   }  // teardown
+
+   // begin on a const array gives a const_iterator
+   void test_beginConst()
+   {  // setup
+      custom::array<Spy, 4> aRW;
+      setupStandardFixture(aRW);
+      const custom::array<Spy, 4> a(aRW);
+      Spy::reset();
+      // exercise
+      custom::array<Spy, 4>::const_iterator it = a.begin();
+      // verify
+      assertUnit(it.p == &(a.__elems_[0]));
+      assertUnit(*it == Spy(26));
+      assertUnit(a.end() - a.begin() == 4);
+      assertStandardFixture(a);
+   }  // teardown
+
+   // an iterator converts to a const_iterator and compares with it
+   void test_constIterator_fromIterator()
+   {  // setup
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      custom::array<Spy, 4>::iterator it = a.begin() + 2;
+      // exercise
+      custom::array<Spy, 4>::const_iterator itConst = it;
+      // verify
+      assertUnit(itConst.p == &(a.__elems_[2]));
+      assertUnit(itConst == it);
+      assertUnit(it == itConst);
+      assertUnit(a.cend() - it == 2);
+      assertStandardFixture(a);
+   }  // teardown
+
+   // walk the standard fixture backwards
+   void test_rbegin_walk()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      int values[4];
+      int i = 0;
+      // exercise
+      for (auto it = a.rbegin(); it != a.rend(); ++it)
+         values[i++] = it->get();
+      // verify
+      assertUnit(i == 4);
+      assertUnit(values[0] == 89);
+      assertUnit(values[1] == 67);
+      assertUnit(values[2] == 49);
+      assertUnit(values[3] == 26);
+      assertStandardFixture(a);
+   }  // teardown
+
+   // walk a const array backwards
+   void test_crbegin_walk()
+   {  // setup
+      custom::array<Spy, 4> aRW;
+      setupStandardFixture(aRW);
+      const custom::array<Spy, 4> a(aRW);
+      // exercise
+      custom::array<Spy, 4>::const_reverse_iterator it = a.crbegin();
+      // verify
+      assertUnit(*it == Spy(89));
+      assertUnit(it[3] == Spy(26));
+      assertUnit(a.crend() - a.crbegin() == 4);
+      assertStandardFixture(a);
+   }  // teardown
+
+   /***************************************
+    * STANDARD ALGORITHMS
+    ***************************************/
+
+   // std::sort accepts the iterator
+   void test_algorithm_sort()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 89 | 67 | 26 | 49 |
+      //    +----+----+----+----+
+      custom::array<Spy, 4> a;
+      a.__elems_[0] = Spy(89);
+      a.__elems_[1] = Spy(67);
+      a.__elems_[2] = Spy(26);
+      a.__elems_[3] = Spy(49);
+      Spy::reset();
+      // exercise
+      std::sort(a.begin(), a.end());
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertStandardFixture(a);
+   }  // teardown
+
+   // std::lower_bound accepts the iterator
+   void test_algorithm_lowerBound()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::array<Spy, 4> aRW;
+      setupStandardFixture(aRW);
+      const custom::array<Spy, 4> a(aRW);
+      Spy s(50);
+      // exercise
+      custom::array<Spy, 4>::const_iterator it =
+         std::lower_bound(a.begin(), a.end(), s);
+      // verify
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //                it
+      assertUnit(it.p == &(a.__elems_[2]));
+      assertStandardFixture(a);
+   }  // teardown
+
+   // std::copy accepts the iterator
+   void test_algorithm_copy()
+   {  // setup
+      custom::array<int, 4> aSource = custom::to_array({ 26, 49, 67, 89 });
+      custom::array<int, 4> aDest{};
+      // exercise
+      custom::array<int, 4>::iterator it =
+         std::copy(aSource.cbegin(), aSource.cend(), aDest.begin());
+      // verify
+      assertUnit(it == aDest.end());
+      assertUnit(aDest[0] == 26);
+      assertUnit(aDest[1] == 49);
+      assertUnit(aDest[2] == 67);
+      assertUnit(aDest[3] == 89);
+   }  // teardown
+
+   /***************************************
+    * FILL and SWAP
+    ***************************************/
+
+   // fill the standard fixture with one value
+   void test_fill_standard()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      a.fill(s);
+      // verify
+      assertUnit(Spy::numAssign() == 4);   // a[i] = 99
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 99 | 99 | 99 | 99 |
+      //    +----+----+----+----+
+      assertUnit(a.__elems_[0] == Spy(99));
+      assertUnit(a.__elems_[1] == Spy(99));
+      assertUnit(a.__elems_[2] == Spy(99));
+      assertUnit(a.__elems_[3] == Spy(99));
+   }  // teardown
+
+   // swap two arrays
+   void test_swap_standard()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::array<Spy, 4> aLHS;
+      setupStandardFixture(aLHS);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 11 | 22 | 33 | 44 |
+      //    +----+----+----+----+
+      custom::array<Spy, 4> aRHS;
+      aRHS.__elems_[0] = Spy(11);
+      aRHS.__elems_[1] = Spy(22);
+      aRHS.__elems_[2] = Spy(33);
+      aRHS.__elems_[3] = Spy(44);
+      Spy::reset();
+      // exercise
+      aRHS.swap(aLHS);
+      // verify
+      assertUnit(Spy::numCopyMove() == 4);   // temp(move(a[i]))
+      assertUnit(Spy::numAssignMove() == 8); // a[i] = move(...)
+      assertUnit(Spy::numDestructor() == 4); // temp
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 11 | 22 | 33 | 44 |
+      //    +----+----+----+----+
+      assertUnit(aLHS.__elems_[0] == Spy(11));
+      assertUnit(aLHS.__elems_[1] == Spy(22));
+      assertUnit(aLHS.__elems_[2] == Spy(33));
+      assertUnit(aLHS.__elems_[3] == Spy(44));
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertStandardFixture(aRHS);
+   }  // teardown
+
+   // swap two arrays with the non-member function
+   void test_swap_nonmember()
+   {  // setup
+      custom::array<Spy, 4> aLHS;
+      setupStandardFixture(aLHS);
+      custom::array<Spy, 4> aRHS;
+      Spy::reset();
+      // exercise
+      custom::swap(aLHS, aRHS);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(aLHS.__elems_[0].empty());
+      assertUnit(aLHS.__elems_[3].empty());
+      assertStandardFixture(aRHS);
+   }  // teardown
+
+   // fill a large array of plain data
+   void test_fill_trivial()
+   {  // setup
+      custom::array<double, 1000> a;
+      // exercise
+      a.fill(3.5);
+      // verify
+      bool allSet = true;
+      for (int i = 0; i < 1000; i++)
+         allSet = allSet && a.__elems_[i] == 3.5;
+      assertUnit(allSet);
+   }  // teardown
+
+   // fill an array of bytes with one of its own elements
+   void test_fill_bytes()
+   {  // setup
+      custom::array<char, 5> a = { 'a', 'b', 'c', 'd', 'e' };
+      // exercise
+      a.fill(a.__elems_[2]);
+      // verify
+      assertUnit(a.__elems_[0] == 'c');
+      assertUnit(a.__elems_[2] == 'c');
+      assertUnit(a.__elems_[4] == 'c');
+   }  // teardown
+
+   // swap arrays of plain data bigger than one chunk
+   void test_swap_trivial()
+   {  // setup
+      custom::array<int, 300> aLHS;
+      custom::array<int, 300> aRHS;
+      for (int i = 0; i < 300; i++)
+      {
+         aLHS.__elems_[i] = i;
+         aRHS.__elems_[i] = -i;
+      }
+      // exercise
+      aLHS.swap(aRHS);
+      // verify
+      bool swapped = true;
+      for (int i = 0; i < 300; i++)
+         swapped = swapped && aLHS.__elems_[i] == -i && aRHS.__elems_[i] == i;
+      assertUnit(swapped);
+   }  // teardown
+
+   // swapping an array with itself changes nothing
+   void test_swap_self()
+   {  // setup
+      custom::array<int, 300> a;
+      for (int i = 0; i < 300; i++)
+         a.__elems_[i] = i;
+      custom::array<Spy, 4> aSpy;
+      setupStandardFixture(aSpy);
+      // exercise
+      a.swap(a);
+      swap(aSpy, aSpy);
+      // verify
+      bool same = true;
+      for (int i = 0; i < 300; i++)
+         same = same && a.__elems_[i] == i;
+      assertUnit(same);
+      assertStandardFixture(aSpy);
+   }  // teardown
+
+   /***************************************
+    * COMPARISON
+    ***************************************/
+
+   // two arrays with the same values
+   void test_equals_same()
+   {  // setup
+      custom::array<Spy, 4> aLHS;
+      setupStandardFixture(aLHS);
+      custom::array<Spy, 4> aRHS;
+      setupStandardFixture(aRHS);
+      Spy::reset();
+      // exercise
+      bool equals = (aLHS == aRHS);
+      bool notEquals = (aLHS != aRHS);
+      // verify
+      assertUnit(Spy::numEquals() == 8);     // a[i] == b[i], twice
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(equals == true);
+      assertUnit(notEquals == false);
+   }  // teardown
+
+   // stop at the first difference
+   void test_equals_different()
+   {  // setup
+      custom::array<Spy, 4> aLHS;
+      setupStandardFixture(aLHS);
+      custom::array<Spy, 4> aRHS;
+      setupStandardFixture(aRHS);
+      aRHS.__elems_[1] = Spy(11);
+      Spy::reset();
+      // exercise
+      bool equals = (aLHS == aRHS);
+      // verify
+      assertUnit(Spy::numEquals() == 2);     // stops at [1]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(equals == false);
+   }  // teardown
+
+   // integers compared a block at a time
+   void test_equals_trivial()
+   {  // setup
+      custom::array<int, 100> aLHS;
+      for (int i = 0; i < 100; i++)
+         aLHS.__elems_[i] = i;
+      custom::array<int, 100> aRHS = aLHS;
+      // exercise
+      bool before = (aLHS == aRHS);
+      aRHS.__elems_[99] = 0;
+      bool after = (aLHS == aRHS);
+      // verify
+      assertUnit(before == true);
+      assertUnit(after == false);
+   }  // teardown
+
+   // the first difference decides the order
+   void test_lessthan_standard()
+   {  // setup
+      custom::array<Spy, 4> aLHS;
+      setupStandardFixture(aLHS);
+      custom::array<Spy, 4> aRHS;
+      setupStandardFixture(aRHS);
+      aRHS.__elems_[2] = Spy(68);
+      Spy::reset();
+      // exercise
+      bool less = (aLHS < aRHS);
+      // verify
+      assertUnit(Spy::numLessthan() == 5);   // [0] and [1] both ways, then [2]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(less == true);
+      assertUnit(aRHS > aLHS);
+      assertUnit(aLHS <= aRHS);
+      assertUnit(!(aLHS >= aRHS));
+   }  // teardown
+
+   // equal arrays are not less than each other
+   void test_lessthan_equal()
+   {  // setup
+      custom::array<Spy, 4> aLHS;
+      setupStandardFixture(aLHS);
+      custom::array<Spy, 4> aRHS;
+      setupStandardFixture(aRHS);
+      Spy::reset();
+      // exercise
+      bool less = (aLHS < aRHS);
+      // verify
+      assertUnit(Spy::numLessthan() == 8);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(less == false);
+      assertUnit(aLHS <= aRHS);
+      assertUnit(aLHS >= aRHS);
+   }  // teardown
+
+   // negative numbers are smaller even though their bytes are not
+   void test_lessthan_signed()
+   {  // setup
+      custom::array<int, 2> aLHS = { -1, 0 };
+      custom::array<int, 2> aRHS = { 1, 0 };
+      // exercise
+      bool less = (aLHS < aRHS);
+      // verify
+      assertUnit(less == true);
+      assertUnit(!(aRHS < aLHS));
+   }  // teardown
+
+   // unsigned bytes compare like strings
+   void test_lessthan_bytes()
+   {  // setup
+      custom::array<unsigned char, 4> aLHS = { 'a', 'b', 'c', 0xFF };
+      custom::array<unsigned char, 4> aRHS = { 'a', 'b', 'd', 0x00 };
+      // exercise
+      bool less = (aLHS < aRHS);
+      // verify
+      assertUnit(less == true);
+      assertUnit(aRHS > aLHS);
+      assertUnit(aLHS != aRHS);
+   }  // teardown
+
+   // the comparisons work in a constant expression
+   void test_constexpr_compare()
+   {  // setup
+      constexpr custom::array<int, 3> aLHS = { 1, 2, 3 };
+      constexpr custom::array<int, 3> aRHS = { 1, 2, 4 };
+      // exercise
+      constexpr bool equals = (aLHS == aLHS);
+      constexpr bool less   = (aLHS < aRHS);
+      // verify
+      static_assert(equals, "operator == is not constexpr");
+      static_assert(less, "operator < is not constexpr");
+      assertUnit(equals);
+      assertUnit(less);
+   }  // teardown
+
+   /***************************************
+    * CONSTEXPR
+    ***************************************/
+
+   // access elements of an array built by the compiler
+   void test_constexpr_access()
+   {  // setup
+      constexpr custom::array<int, 4> a = custom::to_array({ 26, 49, 67, 89 });
+      // exercise
+      constexpr int valueFront = a.front();
+      constexpr int valueBack  = a.back();
+      constexpr int valueAt    = a.at(1);
+      constexpr int valueIndex = a[2];
+      constexpr size_t size    = a.size();
+      constexpr bool empty     = a.empty();
+      // verify
+      static_assert(valueFront == 26, "front() is not constexpr");
+      assertUnit(valueFront == 26);
+      assertUnit(valueBack == 89);
+      assertUnit(valueAt == 49);
+      assertUnit(valueIndex == 67);
+      assertUnit(size == 4);
+      assertUnit(empty == false);
+   }  // teardown
+
+   // walk an array with an iterator in a constant expression
+   void test_constexpr_iterator()
+   {  // setup
+      constexpr custom::array<int, 4> a = custom::to_array({ 26, 49, 67, 89 });
+      // exercise
+      constexpr int total = [](custom::array<int, 4> copy)
+      {
+         int total = 0;
+         for (auto it = copy.begin(); it != copy.end(); it++)
+            total += *it;
+         return total;
+      }(a);
+      // verify
+      static_assert(total == 231, "iterator is not constexpr");
+      assertUnit(total == 26 + 49 + 67 + 89);
+   }  // teardown
+
+   // fill and swap in a constant expression
+   void test_constexpr_fillSwap()
+   {  // setup
+      // exercise
+      constexpr custom::array<int, 4> a = []()
+      {
+         custom::array<int, 4> aLHS{};
+         custom::array<int, 4> aRHS{};
+         aLHS.fill(7);
+         aRHS.swap(aLHS);
+         return aRHS;
+      }();
+      constexpr int valueFront = a.front();
+      constexpr int valueBack  = a.back();
+      // verify
+      static_assert(valueFront == 7, "fill() or swap() is not constexpr");
+      assertUnit(valueFront == 7);
+      assertUnit(valueBack == 7);
+   }  // teardown
+
+   // build a lookup table from a generator
+   void test_constexpr_makeArray()
+   {  // setup
+      // exercise
+      constexpr custom::array<int, 8> a =
+         custom::make_array<int, 8>([](int i) { return i * i; });
+      // verify
+      static_assert(a[7] == 49, "make_array() is not constexpr");
+      for (int i = 0; i < 8; i++)
+         assertUnit(a[i] == i * i);
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *      0    1    2    3
@@ -0,0 +1,330 @@
+/***********************************************************************
+ * Header:
+ *    TEST BITSET
+ * Summary:
+ *    Unit tests for bitset
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "bitset.h"     // class under test
+#include "unitTest.h"   // unit test baseclass
+
+/***********************************************
+ * TEST BITSET
+ * Unit tests for the bitset class
+ ***********************************************/
+class TestBitset : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_value();
+      test_layout_packed();
+
+      // Access
+      test_subscript_write();
+      test_reference_flip();
+      test_test_error();
+
+      // Modify
+      test_set_all();
+      test_reset_all();
+      test_flip_all();
+      test_set_resetOne();
+
+      // Search
+      test_findFirst_none();
+      test_findFirst_lateWord();
+      test_findNext_walk();
+
+      // Bulk
+      test_bulk_and();
+      test_bulk_or();
+      test_bulk_xor();
+      test_bulk_not();
+      test_equals();
+
+      report("Bitset");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // every bit starts off
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::bitset<100> b;
+      // verify
+      assertUnit(b.size() == 100);
+      assertUnit(b.count() == 0);
+      assertUnit(b.none());
+      assertUnit(b.words[0] == 0 && b.words[1] == 0);
+   }  // teardown
+
+   // the low bits come from a number
+   void test_construct_value()
+   {  // setup
+      // exercise
+      custom::bitset<4> b(0xFF);
+      // verify
+      assertUnit(b.words[0] == 0xF);  // bits past N are dropped
+      assertUnit(b.count() == 4);
+      assertUnit(b.all());
+   }  // teardown
+
+   // 64 flags share one word
+   void test_layout_packed()
+   {  // setup
+      // exercise
+      size_t size = sizeof(custom::bitset<1000000>);
+      // verify
+      assertUnit(sizeof(custom::bitset<64>) == 8);
+      assertUnit(sizeof(custom::bitset<65>) == 16);
+      assertUnit(size == 15625 * 8);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // write through the proxy reference
+   void test_subscript_write()
+   {  // setup
+      custom::bitset<130> b;
+      // exercise
+      b[0] = true;
+      b[64] = true;
+      b[129] = true;
+      b[1] = b[0];
+      // verify
+      assertUnit(b.words[0] == 0x3);
+      assertUnit(b.words[1] == 0x1);
+      assertUnit(b.words[2] == 0x2);
+      assertUnit(b[129] == true);
+      assertUnit(b[128] == false);
+   }  // teardown
+
+   // flip through the proxy reference
+   void test_reference_flip()
+   {  // setup
+      custom::bitset<8> b;
+      // exercise
+      b[3].flip();
+      bool inverse = ~b[3];
+      // verify
+      assertUnit(b.test(3));
+      assertUnit(inverse == false);
+   }  // teardown
+
+   // test off the end
+   void test_test_error()
+   {  // setup
+      custom::bitset<8> b;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         b.test(8);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   /***************************************
+    * MODIFY
+    ***************************************/
+
+   // turn every bit on without touching the padding
+   void test_set_all()
+   {  // setup
+      custom::bitset<70> b;
+      // exercise
+      b.set();
+      // verify
+      assertUnit(b.words[0] == ~0ULL);
+      assertUnit(b.words[1] == 0x3F);
+      assertUnit(b.count() == 70);
+      assertUnit(b.all());
+   }  // teardown
+
+   // turn every bit off
+   void test_reset_all()
+   {  // setup
+      custom::bitset<70> b;
+      b.set();
+      // exercise
+      b.reset();
+      // verify
+      assertUnit(b.none());
+   }  // teardown
+
+   // toggle every bit
+   void test_flip_all()
+   {  // setup
+      custom::bitset<70> b;
+      b.set(3);
+      // exercise
+      b.flip();
+      // verify
+      assertUnit(b.count() == 69);
+      assertUnit(b[3] == false);
+      assertUnit(b.words[1] == 0x3F);
+   }  // teardown
+
+   // one bit at a time
+   void test_set_resetOne()
+   {  // setup
+      custom::bitset<200> b;
+      // exercise
+      b.set(150);
+      b.set(10).set(11, false).flip(12);
+      b.reset(10);
+      // verify
+      assertUnit(b.count() == 2);
+      assertUnit(b[150]);
+      assertUnit(b[12]);
+   }  // teardown
+
+   /***************************************
+    * SEARCH
+    ***************************************/
+
+   // no bits on
+   void test_findFirst_none()
+   {  // setup
+      custom::bitset<300> b;
+      // exercise
+      size_t pos = b.find_first();
+      // verify
+      assertUnit(pos == 300);
+   }  // teardown
+
+   // the first bit on is several words in
+   void test_findFirst_lateWord()
+   {  // setup
+      custom::bitset<300> b;
+      b.set(250);
+      b.set(299);
+      // exercise
+      size_t pos = b.find_first();
+      // verify
+      assertUnit(pos == 250);
+   }  // teardown
+
+   // visit every bit that is on
+   void test_findNext_walk()
+   {  // setup
+      custom::bitset<300> b;
+      b.set(0);
+      b.set(63);
+      b.set(64);
+      b.set(200);
+      b.set(299);
+      size_t found[6];
+      int num = 0;
+      // exercise
+      for (size_t pos = b.find_first(); pos < b.size(); pos = b.find_next(pos))
+         found[num++] = pos;
+      // verify
+      assertUnit(num == 5);
+      assertUnit(found[0] == 0);
+      assertUnit(found[1] == 63);
+      assertUnit(found[2] == 64);
+      assertUnit(found[3] == 200);
+      assertUnit(found[4] == 299);
+      assertUnit(b.find_next(299) == 300);
+   }  // teardown
+
+   /***************************************
+    * BULK
+    ***************************************/
+
+   // and across many words
+   void test_bulk_and()
+   {  // setup
+      custom::bitset<1000> lhs;
+      custom::bitset<1000> rhs;
+      for (size_t i = 0; i < 1000; i += 2)
+         lhs.set(i);
+      for (size_t i = 0; i < 1000; i += 3)
+         rhs.set(i);
+      // exercise
+      custom::bitset<1000> result = lhs & rhs;
+      // verify
+      assertUnit(result.count() == 167);  // multiples of 6
+      assertUnit(result[996]);
+      assertUnit(!result[998]);
+   }  // teardown
+
+   // or across many words
+   void test_bulk_or()
+   {  // setup
+      custom::bitset<1000> lhs;
+      custom::bitset<1000> rhs;
+      lhs.set(1);
+      rhs.set(999);
+      // exercise
+      lhs |= rhs;
+      // verify
+      assertUnit(lhs.count() == 2);
+      assertUnit(lhs[1] && lhs[999]);
+   }  // teardown
+
+   // xor across many words
+   void test_bulk_xor()
+   {  // setup
+      custom::bitset<1000> lhs;
+      custom::bitset<1000> rhs;
+      lhs.set();
+      rhs.set(500);
+      // exercise
+      custom::bitset<1000> result = lhs ^ rhs;
+      // verify
+      assertUnit(result.count() == 999);
+      assertUnit(!result[500]);
+   }  // teardown
+
+   // not keeps the padding clear
+   void test_bulk_not()
+   {  // setup
+      custom::bitset<70> b;
+      // exercise
+      custom::bitset<70> result = ~b;
+      // verify
+      assertUnit(result.all());
+      assertUnit(result.words[1] == 0x3F);
+   }  // teardown
+
+   // equality compares every word
+   void test_equals()
+   {  // setup
+      custom::bitset<1000> lhs;
+      custom::bitset<1000> rhs;
+      lhs.set(700);
+      // exercise
+      bool before = (lhs == rhs);
+      rhs.set(700);
+      bool after = (lhs == rhs);
+      // verify
+      assertUnit(before == false);
+      assertUnit(after == true);
+      assertUnit(!(lhs != rhs));
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,279 @@
+/***********************************************************************
+ * Header:
+ *    TEST BLOOM FILTER
+ * Summary:
+ *    Unit tests for bloom_filter and mapped_bloom_filter
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <cstdint>          // for uintptr_t and uint64_t
+#include <cstdio>           // for std::remove
+#include <memory>           // for std::unique_ptr
+#include <string>           // for std::string
+#include "bloomFilter.h"    // class under test
+#include "unitTest.h"       // unit test baseclass
+
+/***********************************************
+ * TEST BLOOM FILTER
+ * Unit tests for the blocked Bloom filter
+ ***********************************************/
+class TestBloomFilter : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_layout_blocks();
+      test_mask_oneBitPerWord();
+
+      // Insert and query
+      test_contains_empty();
+      test_insert_oneBlock();
+      test_insert_noFalseNegatives();
+      test_contains_falsePositiveRate();
+      test_insert_strings();
+      test_clear();
+
+      // Bulk
+      test_bulk_matchesSingle();
+      test_bulk_partialBatch();
+
+      // Mapped
+      test_mapped_sameAnswers();
+      test_mapped_missingFile();
+
+      report("BloomFilter");
+      std::remove(path);
+   }
+
+   // the scratch file the mapped tests write
+   const char * path = "testBloomFilter.tmp";
+
+   // 64 blocks of 512 bits: big enough to measure a false positive rate
+   typedef custom::bloom_filter<uint64_t, 64> Filter;
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // every block is one whole cache line
+   void test_layout_blocks()
+   {  // setup
+      Filter f;
+      // exercise
+      uintptr_t first  = reinterpret_cast<uintptr_t>(&f.blocks[0]);
+      uintptr_t second = reinterpret_cast<uintptr_t>(&f.blocks[1]);
+      // verify
+      assertUnit(sizeof(custom::bloom_block) == 64);
+      assertUnit(first % 64 == 0);
+      assertUnit(second - first == 64);
+      assertUnit(f.block_count() == 64);
+      assertUnit(f.bit_count() == 64 * 512);
+   }  // teardown
+
+   // a mask has exactly one bit in each word
+   void test_mask_oneBitPerWord()
+   {  // setup
+      bool single = true;
+      // exercise
+      for (uint64_t hash = 1; hash < 1000; hash++)
+      {
+         custom::bloom_block mask;
+         custom::bloomMask(hash * 0x9e3779b97f4a7c15ULL, mask);
+         for (int i = 0; i < custom::bloom_block_words; i++)
+            single = single && mask[i] != 0 && (mask[i] & (mask[i] - 1)) == 0;
+      }
+      // verify
+      assertUnit(single);
+   }  // teardown
+
+   /***************************************
+    * INSERT QUERY
+    ***************************************/
+
+   // nothing is in a new filter
+   void test_contains_empty()
+   {  // setup
+      Filter f;
+      int found = 0;
+      // exercise
+      for (uint64_t key = 0; key < 1000; key++)
+         found += f.contains(key);
+      // verify
+      assertUnit(found == 0);
+   }  // teardown
+
+   // one key sets eight bits, all in the same block
+   void test_insert_oneBlock()
+   {  // setup
+      Filter f;
+      // exercise
+      f.insert(42);
+      // verify
+      int blocksUsed = 0;
+      int bitsSet = 0;
+      for (int b = 0; b < 64; b++)
+      {
+         int bits = 0;
+         for (int i = 0; i < custom::bloom_block_words; i++)
+            for (uint64_t word = f.blocks[b][i]; word; word &= word - 1)
+               bits++;
+         blocksUsed += bits != 0;
+         bitsSet += bits;
+      }
+      assertUnit(blocksUsed == 1);
+      assertUnit(bitsSet == 8);
+      assertUnit(f.contains(42));
+   }  // teardown
+
+   // every key that went in is found
+   void test_insert_noFalseNegatives()
+   {  // setup
+      Filter f;
+      for (uint64_t key = 0; key < 2000; key++)
+         f.insert(key * 7919);
+      int found = 0;
+      // exercise
+      for (uint64_t key = 0; key < 2000; key++)
+         found += f.contains(key * 7919);
+      // verify
+      assertUnit(found == 2000);
+   }  // teardown
+
+   // 16 bits a key: well under two percent of other keys say maybe
+   void test_contains_falsePositiveRate()
+   {  // setup
+      Filter f;
+      for (uint64_t key = 0; key < 2000; key++)
+         f.insert(key);
+      int found = 0;
+      // exercise
+      for (uint64_t key = 1000000; key < 1010000; key++)
+         found += f.contains(key);
+      // verify
+      assertUnit(found < 200);
+   }  // teardown
+
+   // any key std::hash knows
+   void test_insert_strings()
+   {  // setup
+      custom::bloom_filter<std::string, 4> f;
+      // exercise
+      f.insert("10.0.0.1");
+      f.insert("192.168.1.1");
+      // verify
+      assertUnit(f.contains("10.0.0.1"));
+      assertUnit(f.contains("192.168.1.1"));
+   }  // teardown
+
+   // nothing is left behind
+   void test_clear()
+   {  // setup
+      Filter f;
+      for (uint64_t key = 0; key < 100; key++)
+         f.insert(key);
+      // exercise
+      f.clear();
+      // verify
+      int found = 0;
+      for (uint64_t key = 0; key < 100; key++)
+         found += f.contains(key);
+      assertUnit(found == 0);
+   }  // teardown
+
+   /***************************************
+    * BULK
+    ***************************************/
+
+   // a bulk insert and query give the same answers as one at a time
+   void test_bulk_matchesSingle()
+   {  // setup
+      uint64_t keys[500];
+      for (int i = 0; i < 500; i++)
+         keys[i] = (uint64_t)i * 104729;
+      Filter bulk;
+      Filter single;
+      for (int i = 0; i < 500; i++)
+         single.insert(keys[i]);
+      uint64_t probes[1000];
+      for (int i = 0; i < 1000; i++)
+         probes[i] = (uint64_t)i * 52361;
+      bool results[1000];
+      // exercise
+      bulk.insert(keys, 500);
+      size_t found = bulk.contains(probes, 1000, results);
+      // verify
+      bool same = true;
+      size_t count = 0;
+      for (int i = 0; i < 1000; i++)
+      {
+         same = same && results[i] == single.contains(probes[i]);
+         count += results[i];
+      }
+      assertUnit(same);
+      assertUnit(found == count);
+      assertUnit(bulk.contains(keys, 500, results) == 500);
+   }  // teardown
+
+   // fewer keys than a batch
+   void test_bulk_partialBatch()
+   {  // setup
+      Filter f;
+      uint64_t keys[3] = { 5, 6, 7 };
+      bool results[3] = { false, false, false };
+      // exercise
+      f.insert(keys, 2);
+      size_t found = f.contains(keys, 3, results);
+      // verify
+      assertUnit(results[0] && results[1]);
+      assertUnit(found == (size_t)(2 + results[2]));
+   }  // teardown
+
+   /***************************************
+    * MAPPED
+    ***************************************/
+
+   // save, map, and get exactly the answers the filter gave
+   void test_mapped_sameAnswers()
+   {  // setup
+      std::unique_ptr<Filter> f(new Filter);  // as a real deny list would be
+      for (uint64_t key = 0; key < 1000; key++)
+         f->insert(key * 31);
+      f->save(path);
+      // exercise
+      custom::mapped_bloom_filter<uint64_t> m(path);
+      // verify
+      bool same = true;
+      for (uint64_t key = 0; key < 5000; key++)
+         same = same && m.contains(key) == f->contains(key);
+      assertUnit(same);
+      assertUnit(m.block_count() == 64);
+      assertUnit(reinterpret_cast<uintptr_t>(m.blocks.data()) % 64 == 0);
+   }  // teardown
+
+   // there is no file
+   void test_mapped_missingFile()
+   {  // setup
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::mapped_bloom_filter<uint64_t> m("noSuchFile.tmp");
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+};
+
+#endif // DEBUG
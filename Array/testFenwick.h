@@ -0,0 +1,192 @@
+/***********************************************************************
+ * Header:
+ *    TEST FENWICK
+ * Summary:
+ *    Unit tests for fenwick
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "fenwick.h"    // class under test
+#include "unitTest.h"   // unit test baseclass
+
+/***********************************************
+ * TEST FENWICK
+ * Unit tests for the fenwick class
+ ***********************************************/
+class TestFenwick : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_values();
+
+      // Modify
+      test_add_one();
+      test_set_replaces();
+      test_clear();
+      test_add_error();
+
+      // Query
+      test_prefixSum_walk();
+      test_rangeSum_matchesLoop();
+
+      report("Fenwick");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // every sum starts at zero
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::fenwick<int, 10> f;
+      // verify
+      assertUnit(f.size() == 10);
+      assertUnit(f.prefix_sum(10) == 0);
+      assertUnit(f.get(9) == 0);
+   }  // teardown
+
+   /*****************************************
+    * the linear build leaves slot i holding
+    * the sum of values (i & (i + 1)) .. i
+    *****************************************/
+   void test_construct_values()
+   {  // setup
+      custom::array<int, 8> values = { 1, 2, 3, 4, 5, 6, 7, 8 };
+      // exercise
+      custom::fenwick<int, 8> f(values);
+      // verify
+      assertUnit(f.tree[0] == 1);
+      assertUnit(f.tree[1] == 1 + 2);
+      assertUnit(f.tree[2] == 3);
+      assertUnit(f.tree[3] == 1 + 2 + 3 + 4);
+      assertUnit(f.tree[5] == 5 + 6);
+      assertUnit(f.tree[7] == 36);
+      assertUnit(f.get(4) == 5);
+   }  // teardown
+
+   /***************************************
+    * MODIFY
+    ***************************************/
+
+   // one update shows up in every prefix that covers it
+   void test_add_one()
+   {  // setup
+      custom::fenwick<int, 10> f;
+      // exercise
+      f.add(3, 7);
+      // verify
+      assertUnit(f.prefix_sum(3) == 0);
+      assertUnit(f.prefix_sum(4) == 7);
+      assertUnit(f.prefix_sum(10) == 7);
+      assertUnit(f.get(3) == 7);
+   }  // teardown
+
+   // set replaces the value rather than adding to it
+   void test_set_replaces()
+   {  // setup
+      custom::array<long long, 5> values = { 10, 20, 30, 40, 50 };
+      custom::fenwick<long long, 5> f(values);
+      // exercise
+      f.set(2, 5);
+      // verify
+      assertUnit(f.get(2) == 5);
+      assertUnit(f.prefix_sum(5) == 125);
+   }  // teardown
+
+   // back to zero
+   void test_clear()
+   {  // setup
+      custom::array<int, 4> values = { 1, 2, 3, 4 };
+      custom::fenwick<int, 4> f(values);
+      // exercise
+      f.clear();
+      // verify
+      assertUnit(f.prefix_sum(4) == 0);
+   }  // teardown
+
+   // past the last value
+   void test_add_error()
+   {  // setup
+      custom::fenwick<int, 4> f;
+      int numThrown = 0;
+      // exercise
+      try
+      {
+         f.add(4, 1);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      try
+      {
+         f.prefix_sum(5);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      // verify
+      assertUnit(numThrown == 2);
+   }  // teardown
+
+   /***************************************
+    * QUERY
+    ***************************************/
+
+   // every prefix of 1, 2, 3, ...
+   void test_prefixSum_walk()
+   {  // setup
+      custom::fenwick<int, 100> f;
+      for (int i = 0; i < 100; i++)
+         f.add(i, i + 1);
+      bool same = true;
+      // exercise
+      for (int count = 0; count <= 100; count++)
+         same = same && f.prefix_sum(count) == count * (count + 1) / 2;
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // random updates checked against a plain array
+   void test_rangeSum_matchesLoop()
+   {  // setup
+      custom::fenwick<int, 37> f;
+      custom::array<int, 37> plain;
+      plain.fill(0);
+      unsigned int seed = 12345;
+      bool same = true;
+      // exercise
+      for (int step = 0; step < 500; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         size_t index = (seed >> 8) % 37;
+         int delta = (int)((seed >> 4) % 21) - 10;
+         f.add(index, delta);
+         plain[index] += delta;
+
+         size_t first = (seed >> 12) % 38;
+         size_t last = first + (seed >> 20) % (38 - first);
+         int expected = 0;
+         for (size_t i = first; i < last; i++)
+            expected += plain[i];
+         same = same && f.range_sum(first, last) == expected;
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+};
+
+#endif // DEBUG
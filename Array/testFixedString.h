@@ -0,0 +1,319 @@
+/***********************************************************************
+ * Header:
+ *    TEST FIXED STRING
+ * Summary:
+ *    Unit tests for fixed_string
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <map>              // for std::map
+#include <string>           // for std::string
+#include <unordered_map>    // for std::unordered_map
+#include "fixedString.h"    // class under test
+#include "unitTest.h"       // unit test baseclass
+
+/***********************************************
+ * TEST FIXED STRING
+ * Unit tests for the fixed_string class
+ ***********************************************/
+class TestFixedString : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_literal();
+      test_construct_buffer();
+      test_construct_view();
+      test_construct_tooLong();
+      test_construct_constexpr();
+
+      // Insert and remove
+      test_pushBack_full();
+      test_append_hash();
+      test_popBack_zeroes();
+      test_clear();
+
+      // Compare
+      test_equals();
+      test_lessThan_prefix();
+      test_lessThan_unsigned();
+      test_lessThan_embeddedZero();
+
+      // Keys
+      test_key_unorderedMap();
+      test_key_map();
+      test_key_staticMap();
+
+      report("FixedString");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing in use, everything zero
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::fixed_string<8> s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.capacity() == 8);
+      assertUnit(s.chars[0] == '\0');
+      assertUnit(s.chars[7] == '\0');
+      assertUnit(s.view() == "");
+   }  // teardown
+
+   // the characters, then zeros
+   void test_construct_literal()
+   {  // setup
+      // exercise
+      custom::fixed_string<8> s = "GET";
+      // verify
+      assertUnit(s.size() == 3);
+      assertUnit(s[0] == 'G');
+      assertUnit(s.back() == 'T');
+      assertUnit(s.chars[3] == '\0');
+      assertUnit(s.chars[7] == '\0');
+      assertUnit(s == "GET");
+      assertUnit(std::string(s.begin(), s.end()) == "GET");
+   }  // teardown
+
+   // a char buffer is read up to its first zero, not its whole size
+   void test_construct_buffer()
+   {  // setup
+      char buffer[8] = "GET";
+      // exercise
+      custom::fixed_string<8> s = buffer;
+      // verify
+      assertUnit(s.size() == 3);
+      assertUnit(s == "GET");
+      assertUnit(s.hash() == custom::fixed_string<8>("GET").hash());
+   }  // teardown
+
+   // from a string known only at run time
+   void test_construct_view()
+   {  // setup
+      std::string source = "PUT /index";
+      // exercise
+      custom::fixed_string<16> s(source);
+      // verify
+      assertUnit(s.size() == source.size());
+      assertUnit(std::string_view(s) == source);
+   }  // teardown
+
+   // more characters than fit
+   void test_construct_tooLong()
+   {  // setup
+      std::string source = "123456789";
+      int numThrown = 0;
+      // exercise
+      try
+      {
+         custom::fixed_string<8> s(source);
+      }
+      catch (const std::length_error &)
+      {
+         numThrown++;
+      }
+      // verify
+      assertUnit(numThrown == 1);
+   }  // teardown
+
+   // the compiler builds the string and its hash
+   void test_construct_constexpr()
+   {  // setup
+      // exercise
+      constexpr custom::fixed_string<8> s = "HEAD";
+      constexpr uint64_t hash = s.hash();
+      constexpr bool less = custom::fixed_string<8>("GET") < s;
+      // verify
+      assertUnit(hash == custom::fixed_string<8>(std::string("HEAD")).hash());
+      assertUnit(less);
+      assertUnit(s.size() == 4);
+   }  // teardown
+
+   /***************************************
+    * INSERT REMOVE
+    ***************************************/
+
+   // one character at a time until full
+   void test_pushBack_full()
+   {  // setup
+      custom::fixed_string<2> s;
+      int numThrown = 0;
+      // exercise
+      s.push_back('a');
+      s += 'b';
+      try
+      {
+         s.push_back('c');
+      }
+      catch (const std::length_error &)
+      {
+         numThrown++;
+      }
+      // verify
+      assertUnit(numThrown == 1);
+      assertUnit(s == "ab");
+   }  // teardown
+
+   // building up a string gives the same hash as making it at once
+   void test_append_hash()
+   {  // setup
+      custom::fixed_string<16> s = "user";
+      custom::fixed_string<16> whole = "user.name";
+      // exercise
+      s += ".name";
+      // verify
+      assertUnit(s.hash() == whole.hash());
+      assertUnit(s == whole);
+   }  // teardown
+
+   // the removed character goes back to zero and the hash follows
+   void test_popBack_zeroes()
+   {  // setup
+      custom::fixed_string<8> s = "abc";
+      custom::fixed_string<8> shorter = "ab";
+      // exercise
+      s.pop_back();
+      // verify
+      assertUnit(s.chars[2] == '\0');
+      assertUnit(s.hash() == shorter.hash());
+      assertUnit(s == shorter);
+   }  // teardown
+
+   // back to a new string
+   void test_clear()
+   {  // setup
+      custom::fixed_string<8> s = "abcdefgh";
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s == custom::fixed_string<8>());
+   }  // teardown
+
+   /***************************************
+    * COMPARE
+    ***************************************/
+
+   // same characters, different characters, different lengths
+   void test_equals()
+   {  // setup
+      custom::fixed_string<8> a = "abc";
+      custom::fixed_string<8> b(std::string("abc"));
+      custom::fixed_string<8> c = "abd";
+      custom::fixed_string<8> d = "ab";
+      // exercise
+      // verify
+      assertUnit(a == b);
+      assertUnit(a != c);
+      assertUnit(a != d);
+      assertUnit(a != "ab");
+   }  // teardown
+
+   // a prefix sorts first, as it does for std::string
+   void test_lessThan_prefix()
+   {  // setup
+      custom::fixed_string<8> ab = "ab";
+      custom::fixed_string<8> abc = "abc";
+      custom::fixed_string<8> b = "b";
+      // exercise
+      // verify
+      assertUnit(ab < abc);
+      assertUnit(abc < b);
+      assertUnit(!(abc < ab));
+      assertUnit(ab <= ab);
+      assertUnit(b > abc);
+      assertUnit(ab.compare(ab) == 0);
+   }  // teardown
+
+   // bytes past 127 sort after plain ASCII, as they do for std::string
+   void test_lessThan_unsigned()
+   {  // setup
+      custom::fixed_string<4> ascii = "z";
+      custom::fixed_string<4> high(std::string(1, (char)0xE9));
+      // exercise
+      // verify
+      assertUnit(ascii < high);
+      assertUnit((std::string("z") < std::string(1, (char)0xE9)) == (ascii < high));
+   }  // teardown
+
+   // a trailing zero is a character, not padding
+   void test_lessThan_embeddedZero()
+   {  // setup
+      custom::fixed_string<4> ab = "ab";
+      custom::fixed_string<4> abZero(std::string_view("ab\0", 3));
+      // exercise
+      // verify
+      assertUnit(ab != abZero);
+      assertUnit(ab < abZero);
+      assertUnit(abZero.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * KEYS
+    ***************************************/
+
+   // as the key of a hash table
+   void test_key_unorderedMap()
+   {  // setup
+      std::unordered_map<custom::fixed_string<16>, int> counts;
+      // exercise
+      counts["GET"]++;
+      counts["POST"]++;
+      counts["GET"]++;
+      // verify
+      assertUnit(counts.size() == 2);
+      assertUnit(counts["GET"] == 2);
+      assertUnit(counts.at("POST") == 1);
+   }  // teardown
+
+   // as the key of a tree, in std::string order
+   void test_key_map()
+   {  // setup
+      std::map<custom::fixed_string<8>, int> m;
+      // exercise
+      m["beta"] = 2;
+      m["alpha"] = 1;
+      m["alphabet"] = 3;
+      // verify
+      auto it = m.begin();
+      assertUnit(it->first == "alpha");
+      ++it;
+      assertUnit(it->first == "alphabet");
+      ++it;
+      assertUnit(it->first == "beta");
+   }  // teardown
+
+   // as the key of a compile-time table
+   void test_key_staticMap()
+   {  // setup
+      typedef custom::fixed_string<8> Name;
+      constexpr custom::array<std::pair<Name, int>, 3> items =
+      {
+         std::pair<Name, int>("GET", 1),
+         std::pair<Name, int>("PUT", 2),
+         std::pair<Name, int>("DELETE", 3)
+      };
+      // exercise
+      constexpr auto methods = custom::make_static_map(items);
+      // verify
+      assertUnit(methods.at("PUT") == 2);
+      assertUnit(methods.at("DELETE") == 3);
+      assertUnit(!methods.contains("POST"));
+   }  // teardown
+};
+
+#endif // DEBUG
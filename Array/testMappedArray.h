@@ -0,0 +1,331 @@
+/***********************************************************************
+ * Header:
+ *    TEST MAPPED ARRAY
+ * Summary:
+ *    Unit tests for array_view and mapped_array
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <cstdint>         // for uintptr_t
+#include <cstdio>          // for std::remove
+#include <fstream>         // for std::ofstream, to write broken files
+#include <utility>         // for std::move
+#include "mappedArray.h"   // class under test
+#include "unitTest.h"      // unit test baseclass
+
+/***********************************************
+ * TEST MAPPED ARRAY
+ * Unit tests for the array_view and mapped_array classes
+ ***********************************************/
+class TestMappedArray : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // View
+      test_view_fromArray();
+      test_view_at();
+      test_view_iterate();
+
+      // Map
+      test_map_roundTrip();
+      test_map_records();
+      test_map_aligned();
+      test_map_empty();
+      test_map_advise();
+      test_map_move();
+
+      // Errors
+      test_map_missingFile();
+      test_map_badMagic();
+      test_map_wrongElementSize();
+      test_map_truncated();
+      test_write_alignmentTooBig();
+      test_map_alignmentTooBig();
+
+      report("MappedArray");
+      std::remove(path);
+   }
+
+   // the scratch file every test writes
+   const char * path = "testMappedArray.tmp";
+
+   // a fixed-size record, like the ones in the shipped tables
+   struct Record
+   {
+      int    id;
+      float  price;
+      char   code[8];
+   };
+
+   /***************************************
+    * VIEW
+    ***************************************/
+
+   // a view of a custom::array
+   void test_view_fromArray()
+   {  // setup
+      custom::array<int, 4> a = { 26, 49, 67, 89 };
+      // exercise
+      custom::array_view<int> v(a);
+      // verify
+      assertUnit(v.size() == 4);
+      assertUnit(v.data() == a.data());
+      assertUnit(v[1] == 49);
+      assertUnit(v.front() == 26);
+      assertUnit(v.back() == 89);
+   }  // teardown
+
+   // at past the end
+   void test_view_at()
+   {  // setup
+      int elements[2] = { 1, 2 };
+      custom::array_view<int> v(elements, 2);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         v.at(2);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(v.at(1) == 2);
+   }  // teardown
+
+   // the same iterators as custom::array
+   void test_view_iterate()
+   {  // setup
+      int elements[4] = { 26, 49, 67, 89 };
+      custom::array_view<int> v(elements, 4);
+      int total = 0;
+      // exercise
+      for (int value : v)
+         total += value;
+      // verify
+      assertUnit(total == 26 + 49 + 67 + 89);
+      assertUnit(*v.rbegin() == 89);
+      assertUnit(v.end() - v.begin() == 4);
+   }  // teardown
+
+   /***************************************
+    * MAP
+    ***************************************/
+
+   // write a file and map it back
+   void test_map_roundTrip()
+   {  // setup
+      int elements[1000];
+      for (int i = 0; i < 1000; i++)
+         elements[i] = i * i;
+      custom::write_mapped_array(path, elements, 1000);
+      // exercise
+      custom::mapped_array<int> m(path);
+      // verify
+      assertUnit(m.size() == 1000);
+      assertUnit(m[0] == 0);
+      assertUnit(m[999] == 999 * 999);
+      bool same = true;
+      for (int i = 0; i < 1000; i++)
+         same = same && m.at(i) == i * i;
+      assertUnit(same);
+   }  // teardown
+
+   // records come back exactly as written
+   void test_map_records()
+   {  // setup
+      Record records[2] = { { 26, 1.5f, "apple" }, { 49, 2.25f, "pear" } };
+      custom::write_mapped_array(path, records, 2);
+      // exercise
+      custom::mapped_array<Record> m(path);
+      // verify
+      assertUnit(m.size() == 2);
+      assertUnit(m[0].id == 26);
+      assertUnit(m[1].price == 2.25f);
+      assertUnit(std::string(m.back().code) == "pear");
+   }  // teardown
+
+   // the elements start on the alignment asked for
+   void test_map_aligned()
+   {  // setup
+      double elements[3] = { 1.0, 2.0, 3.0 };
+      custom::write_mapped_array(path, elements, 3, 64);
+      // exercise
+      custom::mapped_array<double> m(path);
+      // verify
+      assertUnit(reinterpret_cast<uintptr_t>(m.data()) % 64 == 0);
+      assertUnit(static_cast<const char *>((const void *)m.data()) -
+                 static_cast<const char *>(m.pMapping) == 64);
+      assertUnit(m[2] == 3.0);
+   }  // teardown
+
+   // a file with a header and no elements
+   void test_map_empty()
+   {  // setup
+      custom::write_mapped_array(path, (const int *)nullptr, 0);
+      // exercise
+      custom::mapped_array<int> m(path);
+      // verify
+      assertUnit(m.empty());
+      assertUnit(m.begin() == m.end());
+   }  // teardown
+
+   // hints do not change what is read
+   void test_map_advise()
+   {  // setup
+      int elements[4] = { 26, 49, 67, 89 };
+      custom::write_mapped_array(path, elements, 4);
+      // exercise
+      custom::mapped_array<int> m(path, custom::access_advice::sequential);
+      m.advise(custom::access_advice::random);
+      m.advise(custom::access_advice::will_need);
+      // verify
+      assertUnit(m[3] == 89);
+   }  // teardown
+
+   // moving hands over the mapping
+   void test_map_move()
+   {  // setup
+      int elements[2] = { 26, 49 };
+      custom::write_mapped_array(path, elements, 2);
+      custom::mapped_array<int> mRHS(path);
+      const void * pMapping = mRHS.pMapping;
+      // exercise
+      custom::mapped_array<int> mLHS(std::move(mRHS));
+      // verify
+      assertUnit(mLHS.pMapping == pMapping);
+      assertUnit(mRHS.pMapping == nullptr);
+      assertUnit(mRHS.empty());
+      assertUnit(mLHS[1] == 49);
+   }  // teardown
+
+   /***************************************
+    * ERRORS
+    ***************************************/
+
+   // there is no file
+   void test_map_missingFile()
+   {  // setup
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::mapped_array<int> m("noSuchFile.tmp");
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   // the file is something else
+   void test_map_badMagic()
+   {  // setup
+      {
+         std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+         for (int i = 0; i < 64; i++)
+            fout.put('x');
+      }
+      // exercise
+      // verify
+      assertUnit(throwsOnOpen<int>());
+   }  // teardown
+
+   // the file holds a different type
+   void test_map_wrongElementSize()
+   {  // setup
+      short elements[4] = { 1, 2, 3, 4 };
+      custom::write_mapped_array(path, elements, 4);
+      // exercise
+      // verify
+      assertUnit(throwsOnOpen<int>());
+   }  // teardown
+
+   // the file is shorter than its header says
+   void test_map_truncated()
+   {  // setup
+      custom::mapped_header header = {};
+      memcpy(header.magic, custom::mapped_magic, sizeof(header.magic));
+      header.element_size = sizeof(int);
+      header.count = 100;
+      header.alignment = alignof(int);
+      {
+         std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+         fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+         fout.write("abcd", 4);
+      }
+      // exercise
+      // verify
+      assertUnit(throwsOnOpen<int>());
+   }  // teardown
+
+   // element 0 cannot be aligned past the page the mapping starts on
+   void test_write_alignmentTooBig()
+   {  // setup
+      int elements[2] = { 26, 49 };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::write_mapped_array(path, elements, 2,
+                                    (size_t)custom::mappedPageSize() * 2);
+      }
+      catch (const std::invalid_argument &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   // a file written elsewhere with too big an alignment
+   void test_map_alignmentTooBig()
+   {  // setup
+      custom::mapped_header header = {};
+      memcpy(header.magic, custom::mapped_magic, sizeof(header.magic));
+      header.element_size = sizeof(int);
+      header.count = 0;
+      header.alignment = custom::mappedPageSize() * 2;
+      {
+         std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+         fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+         for (uint64_t i = sizeof(header); i < header.alignment; i++)
+            fout.put('\0');
+      }
+      // exercise
+      // verify
+      assertUnit(throwsOnOpen<int>());
+   }  // teardown
+
+   /*************************************************************
+    * THROWS ON OPEN
+    * Does mapping the scratch file as T throw runtime_error?
+    *************************************************************/
+   template <typename T>
+   bool throwsOnOpen()
+   {
+      try
+      {
+         custom::mapped_array<T> m(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         return true;
+      }
+      return false;
+   }
+};
+
+#endif // DEBUG
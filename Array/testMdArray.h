@@ -0,0 +1,359 @@
+/***********************************************************************
+ * Header:
+ *    TEST MD ARRAY
+ * Summary:
+ *    Unit tests for md_array, md_view and the tiled algorithms
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "mdArray.h"    // class under test
+#include "unitTest.h"   // unit test baseclass
+
+/***********************************************
+ * TEST MD ARRAY
+ * Unit tests for the md_array and md_view classes
+ ***********************************************/
+class TestMdArray : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_layout_rowMajor();
+      test_layout_columnMajor();
+      test_layout_blocked();
+      test_layout_blockedPadding();
+
+      // Access
+      test_access_writeRead();
+      test_at_error();
+      test_view_sharesStorage();
+      test_view_const();
+
+      // Tiles
+      test_tiles_count();
+      test_tiles_clipped();
+      test_tiles_write();
+
+      // Algorithms
+      test_transpose_square();
+      test_transpose_layouts();
+      test_multiply_identity();
+      test_multiply_naive();
+
+      report("MdArray");
+   }
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // rows are contiguous
+   void test_layout_rowMajor()
+   {  // setup
+      typedef custom::row_major::mapping<3, 4> M;
+      // exercise
+      // verify
+      assertUnit(M::required_size == 12);
+      assertUnit(M::index(0, 0) == 0);
+      assertUnit(M::index(0, 3) == 3);
+      assertUnit(M::index(1, 2) == 6);
+      assertUnit(M::index(2, 3) == 11);
+   }  // teardown
+
+   // columns are contiguous
+   void test_layout_columnMajor()
+   {  // setup
+      typedef custom::column_major::mapping<3, 4> M;
+      // exercise
+      // verify
+      assertUnit(M::required_size == 12);
+      assertUnit(M::index(1, 0) == 1);
+      assertUnit(M::index(0, 1) == 3);
+      assertUnit(M::index(1, 2) == 7);
+      assertUnit(M::index(2, 3) == 11);
+   }  // teardown
+
+   /*****************************************
+    * 4 x 4 blocked into 2 x 2 tiles
+    *      +-------+-------+
+    *      | 0  1  | 4  5  |
+    *      | 2  3  | 6  7  |
+    *      +-------+-------+
+    *      | 8  9  | 12 13 |
+    *      | 10 11 | 14 15 |
+    *      +-------+-------+
+    *****************************************/
+   void test_layout_blocked()
+   {  // setup
+      typedef custom::blocked<2, 2>::mapping<4, 4> M;
+      // exercise
+      // verify
+      assertUnit(M::required_size == 16);
+      assertUnit(M::index(0, 1) == 1);
+      assertUnit(M::index(1, 0) == 2);
+      assertUnit(M::index(0, 2) == 4);
+      assertUnit(M::index(1, 3) == 7);
+      assertUnit(M::index(2, 0) == 8);
+      assertUnit(M::index(3, 3) == 15);
+   }  // teardown
+
+   // the edge tiles are padded out to whole tiles
+   void test_layout_blockedPadding()
+   {  // setup
+      typedef custom::blocked<2, 2>::mapping<3, 3> M;
+      // exercise
+      // verify
+      assertUnit(M::required_size == 16);
+      assertUnit(M::index(2, 2) == 12);
+      assertUnit(sizeof(custom::md_array<float, 3, 3, custom::blocked<2, 2> >) ==
+                 16 * sizeof(float));
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // what is written is read back, whatever the layout
+   void test_access_writeRead()
+   {  // setup
+      custom::md_array<int, 3, 5, custom::row_major>     a;
+      custom::md_array<int, 3, 5, custom::column_major>  b;
+      custom::md_array<int, 3, 5, custom::blocked<2, 2> > c;
+      // exercise
+      for (size_t r = 0; r < 3; r++)
+         for (size_t col = 0; col < 5; col++)
+         {
+            a(r, col) = (int)(r * 10 + col);
+            b(r, col) = (int)(r * 10 + col);
+            c(r, col) = (int)(r * 10 + col);
+         }
+      // verify
+      bool same = true;
+      for (size_t r = 0; r < 3; r++)
+         for (size_t col = 0; col < 5; col++)
+            same = same && a(r, col) == b(r, col) && b(r, col) == c(r, col);
+      assertUnit(same);
+      assertUnit(a.data()[6] == 11);
+      assertUnit(b.data()[4] == 11);
+      assertUnit(c.data()[3] == 11);
+   }  // teardown
+
+   // at past the last row or column
+   void test_at_error()
+   {  // setup
+      custom::md_array<int, 2, 3> a;
+      a.fill(0);
+      int numThrown = 0;
+      // exercise
+      try
+      {
+         a.at(2, 0);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      try
+      {
+         a.at(0, 3);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      // verify
+      assertUnit(numThrown == 2);
+      assertUnit(a.at(1, 2) == 0);
+   }  // teardown
+
+   // a view over an existing custom::array
+   void test_view_sharesStorage()
+   {  // setup
+      custom::array<float, 6> storage = { 1, 2, 3, 4, 5, 6 };
+      // exercise
+      custom::md_view<float, 2, 3> v(storage.data());
+      v(1, 0) = 40.0f;
+      // verify
+      assertUnit(v(0, 2) == 3.0f);
+      assertUnit(storage[3] == 40.0f);
+      assertUnit(v.rows() == 2);
+      assertUnit(v.cols() == 3);
+   }  // teardown
+
+   // a view of non-const elements converts to a const one
+   void test_view_const()
+   {  // setup
+      custom::md_array<int, 2, 2> a;
+      a.fill(7);
+      // exercise
+      custom::md_view<const int, 2, 2> v = a.view();
+      // verify
+      assertUnit(v(1, 1) == 7);
+      assertUnit(v.data() == a.data());
+   }  // teardown
+
+   /***************************************
+    * TILES
+    ***************************************/
+
+   // every tile is visited once
+   void test_tiles_count()
+   {  // setup
+      custom::md_array<int, 8, 8> a;
+      int numTiles = 0;
+      size_t numElements = 0;
+      // exercise
+      for (auto && tile : a.view().tiles<4, 2>())
+      {
+         numTiles++;
+         numElements += tile.rows() * tile.cols();
+      }
+      // verify
+      assertUnit(numTiles == 8);
+      assertUnit(numElements == 64);
+   }  // teardown
+
+   // the tiles on the right and bottom edges are smaller
+   void test_tiles_clipped()
+   {  // setup
+      custom::md_array<int, 5, 7> a;
+      custom::md_view<int, 5, 7> v = a.view();
+      // exercise
+      auto tiles = v.tiles<4, 4>();
+      auto it = tiles.begin();
+      custom::md_tile<custom::md_view<int, 5, 7> > first = *it++;
+      custom::md_tile<custom::md_view<int, 5, 7> > second = *it++;
+      custom::md_tile<custom::md_view<int, 5, 7> > third = *it++;
+      custom::md_tile<custom::md_view<int, 5, 7> > fourth = *it++;
+      // verify
+      assertUnit(first.rows() == 4 && first.cols() == 4);
+      assertUnit(second.row() == 0 && second.col() == 4);
+      assertUnit(second.rows() == 4 && second.cols() == 3);
+      assertUnit(third.row() == 4 && third.col() == 0);
+      assertUnit(third.rows() == 1 && third.cols() == 4);
+      assertUnit(fourth.rows() == 1 && fourth.cols() == 3);
+      assertUnit(it == tiles.end());
+   }  // teardown
+
+   // writing through a tile writes the view
+   void test_tiles_write()
+   {  // setup
+      custom::md_array<int, 4, 4, custom::blocked<2, 2> > a;
+      int tileNumber = 0;
+      // exercise
+      for (auto && tile : a.view().tiles<2, 2>())
+      {
+         for (size_t r = 0; r < tile.rows(); r++)
+            for (size_t c = 0; c < tile.cols(); c++)
+               tile(r, c) = tileNumber;
+         tileNumber++;
+      }
+      // verify
+      assertUnit(a(0, 0) == 0 && a(1, 1) == 0);
+      assertUnit(a(0, 3) == 1);
+      assertUnit(a(3, 0) == 2);
+      assertUnit(a(2, 2) == 3);
+      for (int i = 0; i < 16; i++)               // each tile is contiguous
+         assertUnit(a.data()[i] == i / 4);
+   }  // teardown
+
+   /***************************************
+    * ALGORITHMS
+    ***************************************/
+
+   // transpose a matrix bigger than one tile
+   void test_transpose_square()
+   {  // setup
+      custom::md_array<int, 10, 10> src;
+      custom::md_array<int, 10, 10> dst;
+      for (size_t r = 0; r < 10; r++)
+         for (size_t c = 0; c < 10; c++)
+            src(r, c) = (int)(r * 100 + c);
+      // exercise
+      custom::transpose<4>(src.view(), dst.view());
+      // verify
+      bool same = true;
+      for (size_t r = 0; r < 10; r++)
+         for (size_t c = 0; c < 10; c++)
+            same = same && dst(c, r) == src(r, c);
+      assertUnit(same);
+   }  // teardown
+
+   // transpose between different layouts and shapes
+   void test_transpose_layouts()
+   {  // setup
+      custom::md_array<int, 3, 7, custom::column_major> src;
+      custom::md_array<int, 7, 3, custom::blocked<2, 2> > dst;
+      for (size_t r = 0; r < 3; r++)
+         for (size_t c = 0; c < 7; c++)
+            src(r, c) = (int)(r * 100 + c);
+      // exercise
+      custom::transpose<2>(src.view(), dst.view());
+      // verify
+      bool same = true;
+      for (size_t r = 0; r < 3; r++)
+         for (size_t c = 0; c < 7; c++)
+            same = same && dst(c, r) == src(r, c);
+      assertUnit(same);
+   }  // teardown
+
+   // multiply by the identity
+   void test_multiply_identity()
+   {  // setup
+      custom::md_array<float, 3, 3> a;
+      custom::md_array<float, 3, 3> identity;
+      custom::md_array<float, 3, 3> c;
+      identity.fill(0.0f);
+      for (size_t i = 0; i < 3; i++)
+      {
+         identity(i, i) = 1.0f;
+         for (size_t j = 0; j < 3; j++)
+            a(i, j) = (float)(i * 3 + j);
+      }
+      // exercise
+      custom::multiply(a.view(), identity.view(), c.view());
+      // verify
+      bool same = true;
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            same = same && c(i, j) == a(i, j);
+      assertUnit(same);
+   }  // teardown
+
+   // the blocked multiply matches the textbook triple loop
+   void test_multiply_naive()
+   {  // setup
+      custom::md_array<int, 5, 6, custom::row_major>    a;
+      custom::md_array<int, 6, 7, custom::column_major> b;
+      custom::md_array<int, 5, 7, custom::blocked<4, 4> > c;
+      for (size_t i = 0; i < 5; i++)
+         for (size_t m = 0; m < 6; m++)
+            a(i, m) = (int)(i + 2 * m) - 4;
+      for (size_t m = 0; m < 6; m++)
+         for (size_t j = 0; j < 7; j++)
+            b(m, j) = (int)(3 * m) - (int)j;
+      // exercise
+      custom::multiply<2>(a.view(), b.view(), c.view());
+      // verify
+      bool same = true;
+      for (size_t i = 0; i < 5; i++)
+         for (size_t j = 0; j < 7; j++)
+         {
+            int expected = 0;
+            for (size_t m = 0; m < 6; m++)
+               expected += a(i, m) * b(m, j);
+            same = same && c(i, j) == expected;
+         }
+      assertUnit(same);
+   }  // teardown
+};
+
+#endif // DEBUG
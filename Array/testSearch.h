@@ -0,0 +1,199 @@
+/***********************************************************************
+ * Header:
+ *    TEST SEARCH
+ * Summary:
+ *    Unit tests for lower_bound, upper_bound and equal_range
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <algorithm>    // for std::lower_bound and std::upper_bound
+#include <cstdint>      // for uint32_t
+#include <string>       // for std::string
+#include "search.h"     // class under test
+#include "unitTest.h"   // unit test baseclass
+
+/***********************************************
+ * TEST SEARCH
+ * Unit tests for the branchless binary searches
+ ***********************************************/
+class TestSearch : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Lower bound
+      test_lowerBound_one();
+      test_lowerBound_linearOnly();
+      test_lowerBound_matchesStd();
+      test_lowerBound_large();
+      test_lowerBound_const();
+
+      // Upper bound
+      test_upperBound_matchesStd();
+      test_upperBound_duplicates();
+
+      // Equal range
+      test_equalRange_duplicates();
+      test_equalRange_missing();
+      test_equalRange_strings();
+
+      report("Search");
+   }
+
+   /***************************************
+    * LOWER BOUND
+    ***************************************/
+
+   // one element, and values on either side
+   void test_lowerBound_one()
+   {  // setup
+      custom::array<int, 1> a = { 50 };
+      // exercise
+      // verify
+      assertUnit(custom::lower_bound(a, 10) == a.begin());
+      assertUnit(custom::lower_bound(a, 50) == a.begin());
+      assertUnit(custom::lower_bound(a, 90) == a.end());
+   }  // teardown
+
+   // small enough for the linear scan alone
+   void test_lowerBound_linearOnly()
+   {  // setup
+      custom::array<int, 5> a = { 10, 20, 30, 40, 50 };
+      // exercise
+      // verify
+      assertUnit(custom::lower_bound(a, 5) - a.begin() == 0);
+      assertUnit(custom::lower_bound(a, 30) - a.begin() == 2);
+      assertUnit(custom::lower_bound(a, 31) - a.begin() == 3);
+      assertUnit(custom::lower_bound(a, 51) == a.end());
+   }  // teardown
+
+   // the same answer as std::lower_bound for every value, found or not
+   void test_lowerBound_matchesStd()
+   {  // setup
+      custom::array<uint32_t, 100> a;
+      for (int i = 0; i < 100; i++)
+         a[i] = (uint32_t)(i * 3);
+      bool same = true;
+      // exercise
+      for (uint32_t value = 0; value < 305; value++)
+         same = same && custom::lower_bound(a, value) ==
+                        std::lower_bound(a.begin(), a.end(), value);
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // a routing table bigger than the caches
+   void test_lowerBound_large()
+   {  // setup
+      static custom::array<uint32_t, 65536> a;
+      for (int i = 0; i < 65536; i++)
+         a[i] = (uint32_t)i * 2 + 1;
+      bool same = true;
+      // exercise
+      for (uint32_t value = 0; value < 140000; value += 7)
+         same = same && custom::lower_bound(a, value) ==
+                        std::lower_bound(a.begin(), a.end(), value);
+      // verify
+      assertUnit(same);
+      assertUnit(custom::lower_bound(a, 0u) == a.begin());
+      assertUnit(custom::lower_bound(a, 131071u) == a.end() - 1);
+      assertUnit(custom::lower_bound(a, 131072u) == a.end());
+   }  // teardown
+
+   // search a const array
+   void test_lowerBound_const()
+   {  // setup
+      const custom::array<double, 20> a =
+      {
+         0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 4.0, 4.5, 5.0,
+         5.5, 6.0, 6.5, 7.0, 7.5, 8.0, 8.5, 9.0, 9.5, 10.0
+      };
+      // exercise
+      custom::array<double, 20>::const_iterator it = custom::lower_bound(a, 7.25);
+      // verify
+      assertUnit(*it == 7.5);
+      assertUnit(it - a.begin() == 14);
+   }  // teardown
+
+   /***************************************
+    * UPPER BOUND
+    ***************************************/
+
+   // the same answer as std::upper_bound for every value
+   void test_upperBound_matchesStd()
+   {  // setup
+      custom::array<int, 77> a;
+      for (int i = 0; i < 77; i++)
+         a[i] = i / 3 - 10;  // every value three times
+      bool same = true;
+      // exercise
+      for (int value = -12; value < 20; value++)
+         same = same && custom::upper_bound(a, value) ==
+                        std::upper_bound(a.begin(), a.end(), value);
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // past every copy of the value
+   void test_upperBound_duplicates()
+   {  // setup
+      custom::array<int, 8> a = { 1, 2, 2, 2, 2, 2, 2, 3 };
+      // exercise
+      custom::array<int, 8>::iterator it = custom::upper_bound(a, 2);
+      // verify
+      assertUnit(it - a.begin() == 7);
+      assertUnit(custom::upper_bound(a, 3) == a.end());
+      assertUnit(custom::upper_bound(a, 0) == a.begin());
+   }  // teardown
+
+   /***************************************
+    * EQUAL RANGE
+    ***************************************/
+
+   // a run of equal values in the middle of a big array
+   void test_equalRange_duplicates()
+   {  // setup
+      custom::array<int, 200> a;
+      for (int i = 0; i < 200; i++)
+         a[i] = (i < 90) ? i : (i < 130 ? 90 : i);
+      // exercise
+      auto range = custom::equal_range(a, 90);
+      // verify
+      assertUnit(range.first - a.begin() == 90);
+      assertUnit(range.second - a.begin() == 130);
+   }  // teardown
+
+   // a value that is not there
+   void test_equalRange_missing()
+   {  // setup
+      custom::array<int, 40> a;
+      for (int i = 0; i < 40; i++)
+         a[i] = i * 10;
+      // exercise
+      auto range = custom::equal_range(a, 205);
+      // verify
+      assertUnit(range.first == range.second);
+      assertUnit(range.first - a.begin() == 21);
+   }  // teardown
+
+   // a type the vector unit cannot compare
+   void test_equalRange_strings()
+   {  // setup
+      custom::array<std::string, 6> a =
+         { "ant", "bee", "bee", "cat", "dog", "eel" };
+      // exercise
+      auto range = custom::equal_range(a, std::string("bee"));
+      // verify
+      assertUnit(range.first - a.begin() == 1);
+      assertUnit(range.second - a.begin() == 3);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,299 @@
+/***********************************************************************
+ * Header:
+ *    TEST SEGMENT TREE
+ * Summary:
+ *    Unit tests for segment_tree
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <string>          // for std::string
+#include "segmentTree.h"   // class under test
+#include "unitTest.h"      // unit test baseclass
+
+/***********************************************
+ * TEST SEGMENT TREE
+ * Unit tests for the segment_tree class
+ ***********************************************/
+class TestSegmentTree : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_layout();
+      test_construct_padding();
+
+      // Query
+      test_query_sum();
+      test_query_min();
+      test_query_empty();
+      test_query_error();
+      test_query_nonCommutative();
+
+      // Modify
+      test_set_one();
+      test_add_rangeSum();
+      test_add_rangeMax();
+      test_add_thenSet();
+      test_random_sum();
+      test_random_min();
+
+      report("SegmentTree");
+   }
+
+   // joins strings left to right, to check the order of combine
+   struct concat_op
+   {
+      static std::string identity() { return std::string(); }
+      static std::string combine(const std::string & lhs, const std::string & rhs)
+      {
+         return lhs + rhs;
+      }
+      static std::string apply(const std::string & value, const std::string & /* delta */,
+                               size_t /* length */)
+      {
+         return value;
+      }
+   };
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   /*****************************************
+    *               1:10
+    *         2:3          3:7
+    *      4:1   5:2    6:3   7:4
+    *****************************************/
+   void test_construct_layout()
+   {  // setup
+      custom::array<int, 4> values = { 1, 2, 3, 4 };
+      // exercise
+      custom::segment_tree<int, 4> t(values);
+      // verify
+      assertUnit(t.tree[1] == 10);
+      assertUnit(t.tree[2] == 3);
+      assertUnit(t.tree[3] == 7);
+      assertUnit(t.tree[4] == 1);
+      assertUnit(t.tree[7] == 4);
+   }  // teardown
+
+   // the leaves past N hold the identity
+   void test_construct_padding()
+   {  // setup
+      custom::array<int, 5> values = { 5, 3, 8, 1, 9 };
+      // exercise
+      custom::segment_tree<int, 5, custom::min_op<int> > t(values);
+      // verify
+      assertUnit(t.tree[8 + 5] == std::numeric_limits<int>::max());
+      assertUnit(t.tree[8 + 7] == std::numeric_limits<int>::max());
+      assertUnit(t.tree[1] == 1);
+   }  // teardown
+
+   /***************************************
+    * QUERY
+    ***************************************/
+
+   // sums of several ranges
+   void test_query_sum()
+   {  // setup
+      custom::array<int, 6> values = { 1, 2, 3, 4, 5, 6 };
+      custom::segment_tree<int, 6> t(values);
+      // exercise
+      // verify
+      assertUnit(t.query(0, 6) == 21);
+      assertUnit(t.query(1, 4) == 9);
+      assertUnit(t.query(5, 6) == 6);
+      assertUnit(t.get(2) == 3);
+   }  // teardown
+
+   // minimums of several ranges
+   void test_query_min()
+   {  // setup
+      custom::array<int, 7> values = { 5, 3, 8, 1, 9, 2, 7 };
+      custom::segment_tree<int, 7, custom::min_op<int> > t(values);
+      // exercise
+      // verify
+      assertUnit(t.query(0, 7) == 1);
+      assertUnit(t.query(0, 3) == 3);
+      assertUnit(t.query(4, 7) == 2);
+      assertUnit(t.query(6, 7) == 7);
+   }  // teardown
+
+   // an empty range gives the identity
+   void test_query_empty()
+   {  // setup
+      custom::segment_tree<int, 4, custom::max_op<int> > t;
+      // exercise
+      int answer = t.query(2, 2);
+      // verify
+      assertUnit(answer == std::numeric_limits<int>::lowest());
+   }  // teardown
+
+   // a range past the end
+   void test_query_error()
+   {  // setup
+      custom::segment_tree<int, 4> t;
+      int numThrown = 0;
+      // exercise
+      try
+      {
+         t.query(0, 5);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      try
+      {
+         t.add(3, 2, 1);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      // verify
+      assertUnit(numThrown == 2);
+   }  // teardown
+
+   // combine is called with the left range first
+   void test_query_nonCommutative()
+   {  // setup
+      custom::array<std::string, 6> values = { "a", "b", "c", "d", "e", "f" };
+      custom::segment_tree<std::string, 6, concat_op> t(values);
+      // exercise
+      // verify
+      assertUnit(t.query(0, 6) == "abcdef");
+      assertUnit(t.query(1, 5) == "bcde");
+      assertUnit(t.query(3, 4) == "d");
+   }  // teardown
+
+   /***************************************
+    * MODIFY
+    ***************************************/
+
+   // replace one value
+   void test_set_one()
+   {  // setup
+      custom::array<int, 5> values = { 5, 3, 8, 1, 9 };
+      custom::segment_tree<int, 5, custom::min_op<int> > t(values);
+      // exercise
+      t.set(3, 10);
+      // verify
+      assertUnit(t.query(0, 5) == 3);
+      assertUnit(t.get(3) == 10);
+   }  // teardown
+
+   // a lazy add is counted once per value it covers
+   void test_add_rangeSum()
+   {  // setup
+      custom::segment_tree<long long, 10> t;
+      // exercise
+      t.add(2, 8, 5);
+      // verify
+      assertUnit(t.query(0, 10) == 30);
+      assertUnit(t.query(0, 3) == 5);
+      assertUnit(t.query(7, 10) == 5);
+      assertUnit(t.get(1) == 0);
+      assertUnit(t.get(5) == 5);
+   }  // teardown
+
+   // a lazy add moves the maximum
+   void test_add_rangeMax()
+   {  // setup
+      custom::array<int, 6> values = { 4, 9, 2, 7, 3, 1 };
+      custom::segment_tree<int, 6, custom::max_op<int> > t(values);
+      // exercise
+      t.add(2, 6, 5);
+      // verify
+      assertUnit(t.query(0, 6) == 12);  // 7 + 5
+      assertUnit(t.query(0, 2) == 9);
+      assertUnit(t.query(4, 6) == 8);
+   }  // teardown
+
+   // set after a pending add replaces the whole value
+   void test_add_thenSet()
+   {  // setup
+      custom::segment_tree<int, 8> t;
+      t.add(0, 8, 3);
+      // exercise
+      t.set(4, 100);
+      // verify
+      assertUnit(t.get(4) == 100);
+      assertUnit(t.get(5) == 3);
+      assertUnit(t.query(0, 8) == 7 * 3 + 100);
+   }  // teardown
+
+   // random range adds and queries checked against a plain array
+   void test_random_sum()
+   {  // setup
+      custom::segment_tree<int, 37> t;
+      custom::array<int, 37> plain;
+      plain.fill(0);
+      // exercise
+      // verify
+      assertUnit(matchesPlain(t, plain, 0, [](int lhs, int rhs) { return lhs + rhs; }));
+   }  // teardown
+
+   // random range adds and minimums checked against a plain array
+   void test_random_min()
+   {  // setup
+      custom::array<int, 50> plain;
+      for (int i = 0; i < 50; i++)
+         plain[i] = (i * 7919) % 101;
+      custom::segment_tree<int, 50, custom::min_op<int> > t(plain);
+      // exercise
+      // verify
+      assertUnit(matchesPlain(t, plain, std::numeric_limits<int>::max(),
+                              [](int lhs, int rhs) { return lhs < rhs ? lhs : rhs; }));
+   }  // teardown
+
+   /*************************************************************
+    * MATCHES PLAIN
+    * Make the same random range adds to the tree and a plain
+    * array, and check every query against a loop over the array
+    *************************************************************/
+   template <int N, typename Op, typename Combine>
+   bool matchesPlain(custom::segment_tree<int, N, Op> & t, custom::array<int, N> & plain,
+                     int identity, Combine combine)
+   {
+      unsigned int seed = 2024;
+      for (int step = 0; step < 500; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         size_t first = (seed >> 8) % (N + 1);
+         size_t last = first + (seed >> 16) % (N + 1 - first);
+         int delta = (int)((seed >> 4) % 21) - 10;
+         if (step % 3 == 2)
+         {
+            t.set(first % N, delta);
+            plain[first % N] = delta;
+         }
+         else
+         {
+            t.add(first, last, delta);
+            for (size_t i = first; i < last; i++)
+               plain[i] += delta;
+         }
+
+         seed = seed * 1103515245 + 12345;
+         first = (seed >> 8) % (N + 1);
+         last = first + (seed >> 16) % (N + 1 - first);
+         int expected = identity;
+         for (size_t i = first; i < last; i++)
+            expected = combine(expected, plain[i]);
+         if (t.query(first, last) != expected)
+            return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
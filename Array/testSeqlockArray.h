@@ -0,0 +1,273 @@
+/***********************************************************************
+ * Header:
+ *    TEST SEQLOCK ARRAY
+ * Summary:
+ *    Unit tests for seqlock_array
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <atomic>            // for std::atomic
+#include <cstdint>           // for uintptr_t
+#include <thread>            // for std::thread
+#include "seqlockArray.h"    // class under test
+#include "unitTest.h"        // unit test baseclass
+
+/***********************************************
+ * TEST SEQLOCK ARRAY
+ * Unit tests for the seqlock_array class
+ ***********************************************/
+class TestSeqlockArray : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_layout_separateLines();
+
+      // Construct
+      test_construct_default();
+      test_construct_values();
+
+      // Store and load
+      test_store_all();
+      test_store_range();
+      test_store_one();
+      test_store_version();
+      test_store_error();
+      test_load_error();
+
+      // Threads
+      test_threads_consistent();
+      test_threads_rangeConsistent();
+
+      report("SeqlockArray");
+   }
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // the sequence number and the values sit on different cache lines
+   void test_layout_separateLines()
+   {  // setup
+      custom::seqlock_array<double, 16> s;
+      // exercise
+      uintptr_t sequence = reinterpret_cast<uintptr_t>(&s.sequence);
+      uintptr_t values   = reinterpret_cast<uintptr_t>(&s.values);
+      // verify
+      assertUnit(sequence % 64 == 0);
+      assertUnit(values % 64 == 0);
+      assertUnit(sequence / 64 != values / 64);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // every value starts at zero and nothing has been written
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::seqlock_array<int, 4> s;
+      // verify
+      custom::array<int, 4> copy = s.load();
+      assertUnit(copy[0] == 0);
+      assertUnit(copy[3] == 0);
+      assertUnit(s.size() == 4);
+      assertUnit(s.version() == 0);
+   }  // teardown
+
+   // start from existing values
+   void test_construct_values()
+   {  // setup
+      custom::array<double, 3> values = { 1.5, 2.5, 3.5 };
+      // exercise
+      custom::seqlock_array<double, 3> s(values);
+      // verify
+      assertUnit(s.load() == values);
+      assertUnit(s.version() == 0);
+   }  // teardown
+
+   /***************************************
+    * STORE LOAD
+    ***************************************/
+
+   // replace every value
+   void test_store_all()
+   {  // setup
+      custom::seqlock_array<int, 5> s;
+      custom::array<int, 5> values = { 5, 4, 3, 2, 1 };
+      // exercise
+      s.store(values);
+      // verify
+      assertUnit(s.load() == values);
+   }  // teardown
+
+   // replace and read back only part of the array
+   void test_store_range()
+   {  // setup
+      custom::seqlock_array<int, 8> s;
+      custom::array<int, 3> values = { 7, 8, 9 };
+      // exercise
+      s.store(2, values);
+      // verify
+      custom::array<int, 4> copy = s.load<4>(1);
+      assertUnit(copy[0] == 0);
+      assertUnit(copy[1] == 7);
+      assertUnit(copy[2] == 8);
+      assertUnit(copy[3] == 9);
+      assertUnit(s.load(5) == 0);
+   }  // teardown
+
+   // replace one value
+   void test_store_one()
+   {  // setup
+      custom::seqlock_array<long long, 4> s;
+      // exercise
+      s.store(3, 99LL);
+      // verify
+      assertUnit(s.load(3) == 99);
+      assertUnit(s.load(2) == 0);
+   }  // teardown
+
+   // every store counts as one write
+   void test_store_version()
+   {  // setup
+      custom::seqlock_array<int, 4> s;
+      custom::array<int, 4> values = { 1, 2, 3, 4 };
+      // exercise
+      s.store(values);
+      s.store(0, 5);
+      // verify
+      assertUnit(s.version() == 2);
+      assertUnit(s.sequence % 2 == 0);
+   }  // teardown
+
+   // past the end; nothing is written
+   void test_store_error()
+   {  // setup
+      custom::seqlock_array<int, 4> s;
+      custom::array<int, 2> values = { 1, 2 };
+      int numThrown = 0;
+      // exercise
+      try
+      {
+         s.store(3, values);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      // verify
+      assertUnit(numThrown == 1);
+      assertUnit(s.version() == 0);
+      assertUnit(s.load(3) == 0);
+   }  // teardown
+
+   // past the end
+   void test_load_error()
+   {  // setup
+      custom::seqlock_array<int, 4> s;
+      int numThrown = 0;
+      // exercise
+      try
+      {
+         s.load<2>(3);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      try
+      {
+         s.load(4);
+      }
+      catch (const std::out_of_range &)
+      {
+         numThrown++;
+      }
+      // verify
+      assertUnit(numThrown == 2);
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // the writer keeps every value equal; readers never see a torn copy
+   void test_threads_consistent()
+   {  // setup
+      const int num = 20000;
+      custom::seqlock_array<double, 256> s;
+      std::atomic<bool> done(false);
+      std::thread writer([&s, &done, num]()
+      {
+         custom::array<double, 256> values;
+         for (int i = 1; i <= num; i++)
+         {
+            values.fill((double)i);
+            s.store(values);
+         }
+         done.store(true);
+      });
+      bool consistent = true;
+      bool forward = true;
+      double last = 0.0;
+      // exercise
+      while (!done.load())
+      {
+         custom::array<double, 256> copy = s.load();
+         for (int i = 1; i < 256; i++)
+            consistent = consistent && copy[i] == copy[0];
+         forward = forward && copy[0] >= last;
+         last = copy[0];
+      }
+      writer.join();
+      // verify
+      assertUnit(consistent);
+      assertUnit(forward);
+      assertUnit(s.load(255) == (double)num);
+      assertUnit(s.version() == (size_t)num);
+   }  // teardown
+
+   // the same for a copy of part of the array while the writer changes part
+   void test_threads_rangeConsistent()
+   {  // setup
+      const int num = 20000;
+      custom::seqlock_array<int, 64> s;
+      std::atomic<bool> done(false);
+      std::thread writer([&s, &done, num]()
+      {
+         custom::array<int, 32> values;
+         for (int i = 1; i <= num; i++)
+         {
+            values.fill(i);
+            s.store(16, values);
+         }
+         done.store(true);
+      });
+      bool consistent = true;
+      // exercise
+      while (!done.load())
+      {
+         custom::array<int, 16> copy = s.load<16>(24);
+         for (int i = 1; i < 16; i++)
+            consistent = consistent && copy[i] == copy[0];
+      }
+      writer.join();
+      // verify
+      assertUnit(consistent);
+      assertUnit(s.load(0) == 0);
+      assertUnit(s.load(47) == num);
+      assertUnit(s.load(48) == 0);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,402 @@
+/***********************************************************************
+ * Header:
+ *    TEST SIMD
+ * Summary:
+ *    Unit tests for the vectorized array operations
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "simd.h"       // class under test
+#include "unitTest.h"   // unit test baseclass
+#include "spy.h"        // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST SIMD
+ * Unit tests for the simd bulk operations
+ ***********************************************/
+class TestSimd : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Fill
+      test_fill_int();
+      test_fill_double();
+      test_fill_spy();
+
+      // Sum, Min, Max
+      test_sum_int();
+      test_sum_double();
+      test_min_int();
+      test_min_tail();
+      test_max_int();
+      test_max_tail();
+
+      // Find, Count
+      test_find_first();
+      test_find_tail();
+      test_find_missing();
+      test_count_int();
+      test_count_char();
+      test_countLess_unsigned();
+      test_countLessEqual_float();
+
+      // Add, Multiply
+      test_add_int();
+      test_multiply_double();
+
+      // Equal
+      test_equal_same();
+      test_equal_differentLast();
+      test_equal_differentFirst();
+
+      // Has all bits
+      test_hasAllBits_subset();
+      test_hasAllBits_missingTail();
+
+      report("Simd");
+   }
+
+   /***************************************
+    * FILL
+    ***************************************/
+
+   // fill an array whose size is not a multiple of the vector width
+   void test_fill_int()
+   {  // setup
+      custom::array<int, 37> a;
+      // exercise
+      custom::simd::fill(a, 7);
+      // verify
+      for (int i = 0; i < 37; i++)
+         assertUnit(a[i] == 7);
+   }  // teardown
+
+   // fill an array of doubles
+   void test_fill_double()
+   {  // setup
+      custom::array<double, 11> a;
+      // exercise
+      custom::simd::fill(a, 2.5);
+      // verify
+      for (int i = 0; i < 11; i++)
+         assertUnit(a[i] == 2.5);
+   }  // teardown
+
+   // fill with a type that cannot be vectorized uses assignment
+   void test_fill_spy()
+   {  // setup
+      custom::array<Spy, 4> a;
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      custom::simd::fill(a, s);
+      // verify
+      assertUnit(Spy::numAssign() == 4);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(a[0] == Spy(99));
+      assertUnit(a[3] == Spy(99));
+   }  // teardown
+
+   /***************************************
+    * SUM MIN MAX
+    ***************************************/
+
+   // sum 1 + 2 + ... + 100
+   void test_sum_int()
+   {  // setup
+      custom::array<int, 100> a;
+      setupSequence(a);
+      // exercise
+      int total = custom::simd::sum(a);
+      // verify
+      assertUnit(total == 5050);
+   }  // teardown
+
+   // sum of doubles that are exact in binary
+   void test_sum_double()
+   {  // setup
+      custom::array<double, 21> a;
+      custom::simd::fill(a, 0.5);
+      // exercise
+      double total = custom::simd::sum(a);
+      // verify
+      assertUnit(total == 10.5);
+   }  // teardown
+
+   // smallest value in the middle of the vector section
+   void test_min_int()
+   {  // setup
+      custom::array<int, 100> a;
+      setupSequence(a);
+      a[40] = -3;
+      // exercise
+      int smallest = custom::simd::min(a);
+      // verify
+      assertUnit(smallest == -3);
+   }  // teardown
+
+   // smallest value in the scalar tail
+   void test_min_tail()
+   {  // setup
+      custom::array<int, 100> a;
+      setupSequence(a);
+      a[99] = -7;
+      // exercise
+      int smallest = custom::simd::min(a);
+      // verify
+      assertUnit(smallest == -7);
+   }  // teardown
+
+   // largest value in the middle of the vector section
+   void test_max_int()
+   {  // setup
+      custom::array<int, 100> a;
+      setupSequence(a);
+      a[5] = 1000;
+      // exercise
+      int largest = custom::simd::max(a);
+      // verify
+      assertUnit(largest == 1000);
+   }  // teardown
+
+   // largest value in the scalar tail
+   void test_max_tail()
+   {  // setup
+      custom::array<int, 99> a;
+      custom::simd::fill(a, 0);
+      a[98] = 42;
+      // exercise
+      int largest = custom::simd::max(a);
+      // verify
+      assertUnit(largest == 42);
+   }  // teardown
+
+   /***************************************
+    * FIND COUNT
+    ***************************************/
+
+   // find the first of two matches
+   void test_find_first()
+   {  // setup
+      custom::array<int, 100> a;
+      setupSequence(a);
+      a[70] = 30;
+      // exercise
+      size_t index = custom::simd::find(a, 30);
+      // verify
+      assertUnit(index == 29);
+   }  // teardown
+
+   // find a value in the scalar tail
+   void test_find_tail()
+   {  // setup
+      custom::array<int, 101> a;
+      setupSequence(a);
+      // exercise
+      size_t index = custom::simd::find(a, 101);
+      // verify
+      assertUnit(index == 100);
+   }  // teardown
+
+   // a missing value returns the size
+   void test_find_missing()
+   {  // setup
+      custom::array<int, 100> a;
+      setupSequence(a);
+      // exercise
+      size_t index = custom::simd::find(a, -1);
+      // verify
+      assertUnit(index == 100);
+   }  // teardown
+
+   // count the matches across the vector section and the tail
+   void test_count_int()
+   {  // setup
+      custom::array<int, 37> a;
+      custom::simd::fill(a, 0);
+      a[0] = a[17] = a[36] = 5;
+      // exercise
+      size_t matches = custom::simd::count(a, 5);
+      // verify
+      assertUnit(matches == 3);
+   }  // teardown
+
+   // count in a byte array where many lanes match at once
+   void test_count_char()
+   {  // setup
+      custom::array<char, 200> a;
+      custom::simd::fill(a, 'x');
+      a[3] = 'y';
+      // exercise
+      size_t matches = custom::simd::count(a, 'x');
+      // verify
+      assertUnit(matches == 199);
+   }  // teardown
+
+   // unsigned lanes compare as unsigned
+   void test_countLess_unsigned()
+   {  // setup
+      custom::array<unsigned int, 37> a;
+      for (int i = 0; i < 37; i++)
+         a[i] = (i < 30) ? (unsigned int)i : 0x80000000u + i;
+      // exercise
+      size_t less = custom::simd::count_less(a, 20u);
+      size_t lessHigh = custom::simd::count_less(a, 0x80000000u + 35);
+      // verify
+      assertUnit(less == 20);
+      assertUnit(lessHigh == 35);
+   }  // teardown
+
+   // elements equal to the value are counted
+   void test_countLessEqual_float()
+   {  // setup
+      custom::array<float, 37> a;
+      for (int i = 0; i < 37; i++)
+         a[i] = i * 0.5f;
+      // exercise
+      size_t lessEqual = custom::simd::count_less_equal(a, 10.0f);
+      // verify
+      assertUnit(lessEqual == 21);
+   }  // teardown
+
+   /***************************************
+    * ADD MULTIPLY
+    ***************************************/
+
+   // add two arrays element-wise
+   void test_add_int()
+   {  // setup
+      custom::array<int, 37> lhs;
+      custom::array<int, 37> rhs;
+      custom::array<int, 37> result;
+      setupSequence(lhs);
+      custom::simd::fill(rhs, 10);
+      // exercise
+      custom::simd::add(lhs, rhs, result);
+      // verify
+      for (int i = 0; i < 37; i++)
+         assertUnit(result[i] == i + 11);
+   }  // teardown
+
+   // multiply two arrays element-wise
+   void test_multiply_double()
+   {  // setup
+      custom::array<double, 19> lhs;
+      custom::array<double, 19> rhs;
+      custom::array<double, 19> result;
+      for (int i = 0; i < 19; i++)
+         lhs[i] = (double)i;
+      custom::simd::fill(rhs, 0.5);
+      // exercise
+      custom::simd::multiply(lhs, rhs, result);
+      // verify
+      for (int i = 0; i < 19; i++)
+         assertUnit(result[i] == i * 0.5);
+   }  // teardown
+
+   /***************************************
+    * EQUAL
+    ***************************************/
+
+   // two identical arrays
+   void test_equal_same()
+   {  // setup
+      custom::array<int, 37> lhs;
+      custom::array<int, 37> rhs;
+      setupSequence(lhs);
+      setupSequence(rhs);
+      // exercise
+      bool same = custom::simd::equal(lhs, rhs);
+      // verify
+      assertUnit(same == true);
+   }  // teardown
+
+   // arrays that differ only in the scalar tail
+   void test_equal_differentLast()
+   {  // setup
+      custom::array<int, 37> lhs;
+      custom::array<int, 37> rhs;
+      setupSequence(lhs);
+      setupSequence(rhs);
+      rhs[36] = 0;
+      // exercise
+      bool same = custom::simd::equal(lhs, rhs);
+      // verify
+      assertUnit(same == false);
+   }  // teardown
+
+   // arrays that differ in the first vector
+   void test_equal_differentFirst()
+   {  // setup
+      custom::array<int, 37> lhs;
+      custom::array<int, 37> rhs;
+      setupSequence(lhs);
+      setupSequence(rhs);
+      lhs[0] = 0;
+      // exercise
+      bool same = custom::simd::equal(lhs, rhs);
+      // verify
+      assertUnit(same == false);
+   }  // teardown
+
+   /***************************************
+    * HAS ALL BITS
+    ***************************************/
+
+   // one bit in every word, all of them set
+   void test_hasAllBits_subset()
+   {  // setup
+      custom::array<unsigned long long, 8> bits;
+      custom::array<unsigned long long, 8> mask;
+      for (int i = 0; i < 8; i++)
+      {
+         bits[i] = 0xF0F0F0F0F0F0F0F0ULL;
+         mask[i] = 1ULL << (4 + i * 8);
+      }
+      // exercise
+      bool all = custom::simd::has_all_bits(bits, mask);
+      // verify
+      assertUnit(all == true);
+      assertUnit(custom::simd::has_all_bits(mask, mask) == true);
+      assertUnit(custom::simd::has_all_bits(mask, bits) == false);
+   }  // teardown
+
+   // one bit missing in the scalar tail
+   void test_hasAllBits_missingTail()
+   {  // setup
+      custom::array<unsigned int, 37> bits;
+      custom::array<unsigned int, 37> mask;
+      bits.fill(0xFFFFFFFFu);
+      mask.fill(0x80000001u);
+      bits[36] = 0x7FFFFFFFu;
+      // exercise
+      bool all = custom::simd::has_all_bits(bits, mask);
+      // verify
+      assertUnit(all == false);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP SEQUENCE
+    *      0    1    2         N-1
+    *    +----+----+----+ ... +----+
+    *    |  1 |  2 |  3 | ... |  N |
+    *    +----+----+----+ ... +----+
+    *************************************************************/
+   template <int N>
+   void setupSequence(custom::array<int, N> & a)
+   {
+      for (int i = 0; i < N; i++)
+         a.__elems_[i] = i + 1;
+   }
+};
+
+#endif // DEBUG
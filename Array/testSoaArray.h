@@ -0,0 +1,294 @@
+/***********************************************************************
+ * Header:
+ *    TEST SOA ARRAY
+ * Summary:
+ *    Unit tests for soa_array
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <cstdint>      // for uintptr_t
+#include "soaArray.h"   // class under test
+#include "simd.h"       // the bulk operations run over one field
+#include "unitTest.h"   // unit test baseclass
+#include "spy.h"        // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST SOA ARRAY
+ * Unit tests for the soa_array class
+ ***********************************************/
+class TestSoaArray : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_layout_fieldsContiguous();
+      test_size();
+
+      // Access
+      test_get_write();
+      test_subscript_readRecord();
+      test_subscript_writeRecord();
+      test_subscript_copyRecord();
+      test_at_error();
+
+      // Iterator
+      test_iterator_walk();
+      test_iterator_const();
+      test_iterator_random();
+      test_iterator_randomBack();
+      test_iterator_toConst();
+
+      // Fields
+      test_field_simd();
+      test_field_spy();
+
+      report("SoaArray");
+   }
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // one field is a plain contiguous array
+   void test_layout_fieldsContiguous()
+   {  // setup
+      custom::soa_array<8, float, double, int> a;
+      // exercise
+      custom::array<double, 8> & y = a.field<1>();
+      // verify
+      assertUnit(&y[0] == &a.get<1>(0));
+      assertUnit(&y[7] == &a.get<1>(7));
+      assertUnit(address(&a.get<1>(1)) - address(&a.get<1>(0)) == sizeof(double));
+      assertUnit(address(&a.get<2>(1)) - address(&a.get<2>(0)) == sizeof(int));
+   }  // teardown
+
+   // size and number of fields
+   void test_size()
+   {  // setup
+      // exercise
+      const custom::soa_array<8, float, double, int> a{};
+      // verify
+      assertUnit(a.size() == 8);
+      assertUnit(a.empty() == false);
+      assertUnit(a.num_fields() == 3);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // write one field of one record
+   void test_get_write()
+   {  // setup
+      custom::soa_array<4, int, char> a{};
+      // exercise
+      a.get<0>(2) = 67;
+      a.get<1>(2) = 'c';
+      // verify
+      assertUnit(a.field<0>()[2] == 67);
+      assertUnit(a.field<1>()[2] == 'c');
+      assertUnit(a.field<0>()[1] == 0);
+   }  // teardown
+
+   // read a whole record through the proxy
+   void test_subscript_readRecord()
+   {  // setup
+      custom::soa_array<4, int, char> a{};
+      a.get<0>(1) = 49;
+      a.get<1>(1) = 'b';
+      // exercise
+      std::tuple<int, char> record = a[1];
+      // verify
+      assertUnit(std::get<0>(record) == 49);
+      assertUnit(std::get<1>(record) == 'b');
+      assertUnit(a[1].get<0>() == 49);
+      assertUnit(a[1] == std::make_tuple(49, 'b'));
+   }  // teardown
+
+   // write a whole record through the proxy
+   void test_subscript_writeRecord()
+   {  // setup
+      custom::soa_array<4, int, char> a{};
+      // exercise
+      a[3] = std::make_tuple(89, 'd');
+      a[0].get<0>() = 26;
+      // verify
+      assertUnit(a.field<0>()[3] == 89);
+      assertUnit(a.field<1>()[3] == 'd');
+      assertUnit(a.field<0>()[0] == 26);
+   }  // teardown
+
+   // assigning one proxy to another copies values, not references
+   void test_subscript_copyRecord()
+   {  // setup
+      custom::soa_array<4, int, char> a{};
+      a[0] = std::make_tuple(26, 'a');
+      a[1] = std::make_tuple(49, 'b');
+      // exercise
+      a[1] = a[0];
+      // verify
+      assertUnit(a[1] == std::make_tuple(26, 'a'));
+      assertUnit(a[0] == std::make_tuple(26, 'a'));
+      a.get<0>(0) = 0;
+      assertUnit(a.get<0>(1) == 26);
+   }  // teardown
+
+   // at past the end
+   void test_at_error()
+   {  // setup
+      custom::soa_array<4, int, char> a{};
+      bool thrown = false;
+      // exercise
+      try
+      {
+         a.at(4);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk every record, array-of-structs style
+   void test_iterator_walk()
+   {  // setup
+      custom::soa_array<5, int, int> a{};
+      for (int i = 0; i < 5; i++)
+         a[i] = std::make_tuple(i, i * 10);
+      int total = 0;
+      int count = 0;
+      // exercise
+      for (auto it = a.begin(); it != a.end(); ++it)
+      {
+         total += (*it).get<0>() + (*it).get<1>();
+         count++;
+      }
+      // verify
+      assertUnit(count == 5);
+      assertUnit(total == (0 + 1 + 2 + 3 + 4) * 11);
+   }  // teardown
+
+   // walk a const soa_array
+   void test_iterator_const()
+   {  // setup
+      custom::soa_array<3, int, char> aRW{};
+      aRW[2] = std::make_tuple(67, 'c');
+      const custom::soa_array<3, int, char> & a = aRW;
+      // exercise
+      custom::soa_array<3, int, char>::const_iterator it = a.begin();
+      ++it;
+      it++;
+      // verify
+      assertUnit(*it == std::make_tuple(67, 'c'));
+      assertUnit(a.end() - a.begin() == 3);
+   }  // teardown
+
+   // jump around the records
+   void test_iterator_random()
+   {  // setup
+      custom::soa_array<4, int> a{};
+      for (int i = 0; i < 4; i++)
+         a.get<0>(i) = i + 1;
+      custom::soa_array<4, int>::iterator it = a.begin();
+      // exercise
+      it += 3;
+      // verify
+      assertUnit((*it).get<0>() == 4);
+      assertUnit(it[-2].get<0>() == 2);
+      assertUnit((a.begin() + 1) < it);
+      assertUnit(--it - a.begin() == 2);
+   }  // teardown
+
+   // step back and compare in every direction
+   void test_iterator_randomBack()
+   {  // setup
+      custom::soa_array<4, int> a{};
+      for (int i = 0; i < 4; i++)
+         a.get<0>(i) = i + 1;
+      custom::soa_array<4, int>::iterator it = a.end();
+      // exercise
+      it -= 1;
+      // verify
+      assertUnit((*it).get<0>() == 4);
+      assertUnit((*(it - 3)).get<0>() == 1);
+      assertUnit(2 + a.begin() == a.begin() + 2);
+      assertUnit(it > a.begin());
+      assertUnit(!(a.begin() > a.begin()));
+      assertUnit(a.begin() <= a.begin());
+      assertUnit(a.begin() <= it);
+      assertUnit(!(it <= a.begin()));
+      assertUnit(it >= it);
+      assertUnit(a.end() >= it);
+      assertUnit(!(a.begin() >= it));
+   }  // teardown
+
+   // an iterator turns into a const_iterator at the same record
+   void test_iterator_toConst()
+   {  // setup
+      typedef custom::soa_array<3, int, char> Soa;
+      Soa a{};
+      a[1] = std::make_tuple(49, 'b');
+      Soa::iterator it = a.begin() + 1;
+      // exercise
+      Soa::const_iterator cit = it;
+      // verify
+      assertUnit(*cit == std::make_tuple(49, 'b'));
+      assertUnit(cit - Soa::const_iterator(a.begin()) == 1);
+      assertUnit(cit == it);
+   }  // teardown
+
+   /***************************************
+    * FIELDS
+    ***************************************/
+
+   // a single-field scan runs through the simd kernels
+   void test_field_simd()
+   {  // setup
+      custom::soa_array<100, float, int> a{};
+      custom::simd::fill(a.field<1>(), 3);
+      // exercise
+      int total = custom::simd::sum(a.field<1>());
+      // verify
+      assertUnit(total == 300);
+      assertUnit(custom::simd::count(a.field<0>(), 0.0f) == 100);
+   }  // teardown
+
+   // reading and writing records does not copy the class type fields
+   void test_field_spy()
+   {  // setup
+      custom::soa_array<4, Spy, int> a;
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      a[2].get<0>() = s;
+      // verify
+      assertUnit(Spy::numAssign() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(a.field<0>()[2] == Spy(99));
+   }  // teardown
+
+   // the address of a pointer as a number
+   template <typename P>
+   static uintptr_t address(const P * p)
+   {
+      return reinterpret_cast<uintptr_t>(p);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,249 @@
+/***********************************************************************
+ * Header:
+ *    TEST SORTING NETWORK
+ * Summary:
+ *    Unit tests for the sorting networks and custom::sort
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <cmath>              // for std::isnan and std::signbit
+#include <functional>         // for std::greater
+#include "sortingNetwork.h"   // class under test
+#include "unitTest.h"         // unit test baseclass
+#include "spy.h"              // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST SORTING NETWORK
+ * Unit tests for sorting_network and sort
+ ***********************************************/
+class TestSortingNetwork : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Network
+      test_network_optimalSizes();
+      test_network_zeroOne();
+
+      // Sort
+      test_sort_tiny();
+      test_sort_reversed();
+      test_sort_duplicates();
+      test_sort_floats();
+      test_sort_nan();
+      test_sort_negativeZero();
+      test_sort_greater();
+      test_sort_spy();
+      test_sort_aboveLimit();
+
+      report("SortingNetwork");
+   }
+
+   /***************************************
+    * NETWORK
+    ***************************************/
+
+   // the known optimal sizes up to 8, and close after that
+   void test_network_optimalSizes()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(custom::sorting_network<1>::size == 0);
+      assertUnit(custom::sorting_network<2>::size == 1);
+      assertUnit(custom::sorting_network<3>::size == 3);
+      assertUnit(custom::sorting_network<4>::size == 5);
+      assertUnit(custom::sorting_network<5>::size == 9);
+      assertUnit(custom::sorting_network<6>::size == 12);
+      assertUnit(custom::sorting_network<7>::size == 16);
+      assertUnit(custom::sorting_network<8>::size == 19);
+      assertUnit(custom::sorting_network<16>::size == 63);
+      assertUnit(custom::sorting_network<32>::size == 191);
+   }  // teardown
+
+   // a network that sorts every string of 0s and 1s sorts everything
+   void test_network_zeroOne()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(sortsZeroOne<2>());
+      assertUnit(sortsZeroOne<3>());
+      assertUnit(sortsZeroOne<4>());
+      assertUnit(sortsZeroOne<5>());
+      assertUnit(sortsZeroOne<7>());
+      assertUnit(sortsZeroOne<8>());
+      assertUnit(sortsZeroOne<11>());
+      assertUnit(sortsZeroOne<16>());
+   }  // teardown
+
+   /***************************************
+    * SORT
+    ***************************************/
+
+   // zero, one and two elements
+   void test_sort_tiny()
+   {  // setup
+      custom::array<int, 1> one = { 5 };
+      custom::array<int, 2> two = { 9, 3 };
+      // exercise
+      custom::sort(one);
+      custom::sort(two);
+      // verify
+      assertUnit(one[0] == 5);
+      assertUnit(two[0] == 3);
+      assertUnit(two[1] == 9);
+   }  // teardown
+
+   // the worst case for insertion sort
+   void test_sort_reversed()
+   {  // setup
+      custom::array<int, 32> a;
+      for (int i = 0; i < 32; i++)
+         a[i] = 31 - i;
+      // exercise
+      custom::sort(a);
+      // verify
+      bool sorted = true;
+      for (int i = 0; i < 32; i++)
+         sorted = sorted && a[i] == i;
+      assertUnit(sorted);
+   }  // teardown
+
+   // the same value more than once
+   void test_sort_duplicates()
+   {  // setup
+      custom::array<int, 9> a = { 4, 1, 4, -2, 1, 0, 4, -2, 7 };
+      // exercise
+      custom::sort(a);
+      // verify
+      custom::array<int, 9> expected = { -2, -2, 0, 1, 1, 4, 4, 4, 7 };
+      assertUnit(a == expected);
+   }  // teardown
+
+   // floating point numbers take the min/max path too
+   void test_sort_floats()
+   {  // setup
+      custom::array<double, 6> a = { 2.5, -1.0, 3.25, 0.0, -7.5, 1.0 };
+      // exercise
+      custom::sort(a);
+      // verify
+      custom::array<double, 6> expected = { -7.5, -1.0, 0.0, 1.0, 2.5, 3.25 };
+      bool same = true;
+      for (int i = 0; i < 6; i++)
+         same = same && a[i] == expected[i];
+      assertUnit(same);
+   }  // teardown
+
+   // a NaN is kept once, not copied over the other values
+   void test_sort_nan()
+   {  // setup
+      custom::array<double, 4> a = { NAN, 1.0, 3.0, 2.0 };
+      // exercise
+      custom::sort(a);
+      // verify
+      int numNan = 0;
+      bool seen[4] = { false, false, false, false };
+      for (int i = 0; i < 4; i++)
+      {
+         if (std::isnan(a[i]))
+            numNan++;
+         else if (a[i] == 1.0 || a[i] == 2.0 || a[i] == 3.0)
+            seen[(int)a[i]] = true;
+      }
+      assertUnit(numNan == 1);
+      assertUnit(seen[1] && seen[2] && seen[3]);
+   }  // teardown
+
+   // -0.0 and 0.0 compare equal but both stay
+   void test_sort_negativeZero()
+   {  // setup
+      custom::array<double, 4> a = { 2.0, 0.0, 1.0, -0.0 };
+      // exercise
+      custom::sort(a);
+      // verify
+      assertUnit(a[0] == 0.0 && a[1] == 0.0);
+      assertUnit(std::signbit(a[0]) != std::signbit(a[1]));
+      assertUnit(a[2] == 1.0);
+      assertUnit(a[3] == 2.0);
+   }  // teardown
+
+   // a different order
+   void test_sort_greater()
+   {  // setup
+      custom::array<int, 5> a = { 3, 1, 4, 1, 5 };
+      // exercise
+      custom::sort(a, std::greater<int>());
+      // verify
+      custom::array<int, 5> expected = { 5, 4, 3, 1, 1 };
+      assertUnit(a == expected);
+   }  // teardown
+
+   // one compare per comparator and no copies
+   void test_sort_spy()
+   {  // setup
+      custom::array<Spy, 4> a;
+      a[0] = Spy(89);
+      a[1] = Spy(26);
+      a[2] = Spy(67);
+      a[3] = Spy(49);
+      Spy::reset();
+      // exercise
+      custom::sort(a);
+      // verify
+      assertUnit(Spy::numLessthan() == 5);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(a[0] == Spy(26));
+      assertUnit(a[1] == Spy(49));
+      assertUnit(a[2] == Spy(67));
+      assertUnit(a[3] == Spy(89));
+   }  // teardown
+
+   // past the limit std::sort takes over
+   void test_sort_aboveLimit()
+   {  // setup
+      custom::array<int, 100> a;
+      for (int i = 0; i < 100; i++)
+         a[i] = (i * 37) % 100;
+      // exercise
+      custom::sort(a);
+      // verify
+      bool sorted = true;
+      for (int i = 0; i < 100; i++)
+         sorted = sorted && a[i] == i;
+      assertUnit(sorted);
+   }  // teardown
+
+   /*************************************************************
+    * SORTS ZERO ONE
+    * Does sort put every array of N 0s and 1s in order?
+    *************************************************************/
+   template <int N>
+   bool sortsZeroOne()
+   {
+      for (int bits = 0; bits < (1 << N); bits++)
+      {
+         custom::array<int, N> a;
+         int numOnes = 0;
+         for (int i = 0; i < N; i++)
+         {
+            a[i] = (bits >> i) & 1;
+            numOnes += a[i];
+         }
+         custom::sort(a);
+         for (int i = 0; i < N; i++)
+            if (a[i] != (i >= N - numOnes ? 1 : 0))
+               return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,284 @@
+/***********************************************************************
+ * Header:
+ *    TEST SPSC RING
+ * Summary:
+ *    Unit tests for spsc_ring
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <atomic>       // for std::atomic
+#include <cstdint>      // for uintptr_t
+#include <thread>       // for std::thread
+#include "spscRing.h"   // class under test
+#include "unitTest.h"   // unit test baseclass
+#include "spy.h"        // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST SPSC RING
+ * Unit tests for the spsc_ring class
+ ***********************************************/
+class TestSpscRing : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_layout_separateLines();
+
+      // Push and pop
+      test_pop_empty();
+      test_push_pop();
+      test_push_full();
+      test_push_move();
+      test_wrapAround();
+
+      // Batches
+      test_pushN_partial();
+      test_popN_partial();
+
+      // Threads
+      test_threads_inOrder();
+      test_threads_sizeBounded();
+
+      report("SpscRing");
+   }
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // head, tail and the buffer sit on different cache lines
+   void test_layout_separateLines()
+   {  // setup
+      custom::spsc_ring<int, 8> r;
+      // exercise
+      uintptr_t head   = reinterpret_cast<uintptr_t>(&r.head);
+      uintptr_t tail   = reinterpret_cast<uintptr_t>(&r.tail);
+      uintptr_t buffer = reinterpret_cast<uintptr_t>(r.buffer.data());
+      // verify
+      assertUnit(head / 64 != tail / 64);
+      assertUnit(tail / 64 != buffer / 64);
+      assertUnit(buffer % 64 == 0);
+   }  // teardown
+
+   /***************************************
+    * PUSH POP
+    ***************************************/
+
+   // nothing to pop from a new ring
+   void test_pop_empty()
+   {  // setup
+      custom::spsc_ring<int, 4> r;
+      int value = 99;
+      // exercise
+      bool popped = r.try_pop(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value == 99);
+      assertUnit(r.empty());
+      assertUnit(r.capacity() == 4);
+   }  // teardown
+
+   // first in, first out
+   void test_push_pop()
+   {  // setup
+      custom::spsc_ring<int, 4> r;
+      int first = 0;
+      int second = 0;
+      // exercise
+      r.try_push(26);
+      r.try_push(49);
+      bool poppedFirst = r.try_pop(first);
+      bool poppedSecond = r.try_pop(second);
+      // verify
+      assertUnit(poppedFirst && poppedSecond);
+      assertUnit(first == 26);
+      assertUnit(second == 49);
+      assertUnit(r.empty());
+   }  // teardown
+
+   // a full ring refuses more
+   void test_push_full()
+   {  // setup
+      custom::spsc_ring<int, 4> r;
+      for (int i = 0; i < 4; i++)
+         r.try_push(i);
+      // exercise
+      bool pushed = r.try_push(4);
+      // verify
+      assertUnit(pushed == false);
+      assertUnit(r.size() == 4);
+   }  // teardown
+
+   // a pushed rvalue is moved, not copied
+   void test_push_move()
+   {  // setup
+      custom::spsc_ring<Spy, 2> r;
+      Spy s(67);
+      Spy out;
+      Spy::reset();
+      // exercise
+      r.try_push(std::move(s));
+      r.try_pop(out);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 2);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(out == Spy(67));
+   }  // teardown
+
+   // the indices keep going past the end of the buffer
+   void test_wrapAround()
+   {  // setup
+      custom::spsc_ring<int, 4> r;
+      int value = 0;
+      bool inOrder = true;
+      // exercise
+      for (int i = 0; i < 10; i++)
+      {
+         r.try_push(i);
+         r.try_push(i + 100);
+         r.try_pop(value);
+         inOrder = inOrder && value == i;
+         r.try_pop(value);
+         inOrder = inOrder && value == i + 100;
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(r.empty());
+   }  // teardown
+
+   /***************************************
+    * BATCHES
+    ***************************************/
+
+   // push more than fits
+   void test_pushN_partial()
+   {  // setup
+      custom::spsc_ring<int, 4> r;
+      int items[6] = { 1, 2, 3, 4, 5, 6 };
+      r.try_push(0);
+      // exercise
+      size_t pushed = r.try_push_n(items, 6);
+      // verify
+      assertUnit(pushed == 3);
+      assertUnit(r.size() == 4);
+   }  // teardown
+
+   // pop more than there are
+   void test_popN_partial()
+   {  // setup
+      custom::spsc_ring<int, 8> r;
+      int items[3] = { 26, 49, 67 };
+      r.try_push_n(items, 3);
+      int out[8] = {};
+      // exercise
+      size_t popped = r.try_pop_n(out, 8);
+      // verify
+      assertUnit(popped == 3);
+      assertUnit(out[0] == 26);
+      assertUnit(out[1] == 49);
+      assertUnit(out[2] == 67);
+      assertUnit(out[3] == 0);
+      assertUnit(r.empty());
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // one thread produces, this one consumes, nothing is lost or reordered
+   void test_threads_inOrder()
+   {  // setup
+      const int num = 100000;
+      custom::spsc_ring<int, 64> r;
+      std::thread producer([&r, num]()
+      {
+         int batch[16];
+         int next = 0;
+         while (next < num)
+         {
+            int count = 0;
+            while (count < 16 && next + count < num)
+            {
+               batch[count] = next + count;
+               count++;
+            }
+            int pushed = (int)r.try_push_n(batch, count);
+            if (pushed == 0)
+               std::this_thread::yield();
+            next += pushed;
+         }
+      });
+      int expected = 0;
+      bool inOrder = true;
+      // exercise
+      while (expected < num)
+      {
+         int value;
+         if (r.try_pop(value))
+         {
+            inOrder = inOrder && value == expected;
+            expected++;
+         }
+         else
+            std::this_thread::yield();
+      }
+      producer.join();
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expected == num);
+      assertUnit(r.empty());
+   }  // teardown
+
+   // size() seen from a third thread never wraps or passes N
+   void test_threads_sizeBounded()
+   {  // setup
+      const int num = 100000;
+      custom::spsc_ring<int, 64> r;
+      std::atomic<bool> done(false);
+      bool bounded = true;
+      std::thread watcher([&r, &done, &bounded]()
+      {
+         while (!done.load())
+         {
+            bounded = bounded && r.size() <= 64;
+            std::this_thread::yield();
+         }
+      });
+      std::thread producer([&r, num]()
+      {
+         for (int i = 0; i < num; )
+            if (r.try_push(i))
+               i++;
+            else
+               std::this_thread::yield();
+      });
+      // exercise
+      for (int popped = 0; popped < num; )
+      {
+         int value;
+         if (r.try_pop(value))
+            popped++;
+         else
+            std::this_thread::yield();
+      }
+      producer.join();
+      done.store(true);
+      watcher.join();
+      // verify
+      assertUnit(bounded);
+      assertUnit(r.size() == 0);
+      assertUnit(r.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
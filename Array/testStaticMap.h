@@ -0,0 +1,216 @@
+/***********************************************************************
+ * Header:
+ *    TEST STATIC MAP
+ * Summary:
+ *    Unit tests for static_map
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "staticMap.h"  // class under test
+#include "unitTest.h"   // unit test baseclass
+
+/***********************************************
+ * TEST STATIC MAP
+ * Unit tests for the static_map class
+ ***********************************************/
+class TestStaticMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_tableSize();
+      test_construct_everySlotOnce();
+      test_construct_duplicate();
+
+      // Lookup
+      test_find_stringKeys();
+      test_find_missing();
+      test_find_integerKeys();
+      test_find_compileTime();
+      test_at_error();
+      test_find_handlers();
+
+      report("StaticMap");
+   }
+
+   typedef std::pair<std::string_view, int> Header;
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // the table is the next power of two
+   void test_construct_tableSize()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit((custom::static_map<int, int, 1>::table_size == 1));
+      assertUnit((custom::static_map<int, int, 5>::table_size == 8));
+      assertUnit((custom::static_map<int, int, 8>::table_size == 8));
+      assertUnit((custom::static_map<int, int, 9>::table_size == 16));
+   }  // teardown
+
+   // every key has a slot of its own, even with a full table
+   void test_construct_everySlotOnce()
+   {  // setup
+      static constexpr custom::array<std::pair<int, int>, 16> items =
+      {{
+         { 0, 0 },      { 1000, 1 },   { 2000, 2 },   { 3000, 3 },
+         { 4000, 4 },   { 5000, 5 },   { 6000, 6 },   { 7000, 7 },
+         { 8000, 8 },   { 9000, 9 },   { 10000, 10 }, { 11000, 11 },
+         { 12000, 12 }, { 13000, 13 }, { 14000, 14 }, { 15000, 15 }
+      }};
+      // exercise
+      constexpr custom::static_map<int, int, 16> m(items);
+      // verify
+      int numUsed = 0;
+      for (int slot = 0; slot < 16; slot++)
+         numUsed += m.used[slot] ? 1 : 0;
+      assertUnit(numUsed == 16);
+      bool allFound = true;
+      for (int i = 0; i < 16; i++)
+         allFound = allFound && m.find(i * 1000) && *m.find(i * 1000) == i;
+      assertUnit(allFound);
+   }  // teardown
+
+   // the same key twice, at run time
+   void test_construct_duplicate()
+   {  // setup
+      custom::array<std::pair<int, int>, 3> items =
+         {{ { 26, 1 }, { 49, 2 }, { 26, 3 } }};
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::static_map<int, int, 3> m(items);
+      }
+      catch (const std::invalid_argument &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   /***************************************
+    * LOOKUP
+    ***************************************/
+
+   // look up HTTP header names
+   void test_find_stringKeys()
+   {  // setup
+      static constexpr custom::array<Header, 6> headers =
+      {{
+         { "Accept", 1 }, { "Content-Length", 2 }, { "Content-Type", 3 },
+         { "Host", 4 },   { "User-Agent", 5 },     { "Connection", 6 }
+      }};
+      // exercise
+      constexpr auto m = custom::make_static_map(headers);
+      // verify
+      assertUnit(m.size() == 6);
+      assertUnit(*m.find("Accept") == 1);
+      assertUnit(*m.find("Content-Length") == 2);
+      assertUnit(*m.find("Content-Type") == 3);
+      assertUnit(*m.find("Host") == 4);
+      assertUnit(*m.find("User-Agent") == 5);
+      assertUnit(*m.find("Connection") == 6);
+   }  // teardown
+
+   // keys that are not there, including ones that share a slot
+   void test_find_missing()
+   {  // setup
+      static constexpr custom::array<Header, 3> methods =
+         {{ { "GET", 1 }, { "PUT", 2 }, { "POST", 3 } }};
+      constexpr auto m = custom::make_static_map(methods);
+      // exercise
+      int numFound = 0;
+      const char * probes[] = { "", "get", "PATCH", "DELETE", "GETS", "POS" };
+      for (const char * probe : probes)
+         numFound += (int)m.count(probe);
+      // verify
+      assertUnit(numFound == 0);
+      assertUnit(m.find("DELETE") == nullptr);
+      assertUnit(m.contains("POST"));
+   }  // teardown
+
+   // integer keys
+   void test_find_integerKeys()
+   {  // setup
+      custom::array<std::pair<int, int>, 5> items =
+         {{ { -7, 1 }, { 0, 2 }, { 404, 3 }, { 65536, 4 }, { 2147483647, 5 } }};
+      // exercise
+      custom::static_map<int, int, 5> m(items);
+      // verify
+      assertUnit(m.at(-7) == 1);
+      assertUnit(m.at(0) == 2);
+      assertUnit(m.at(404) == 3);
+      assertUnit(m.at(65536) == 4);
+      assertUnit(m.at(2147483647) == 5);
+      assertUnit(!m.contains(1));
+   }  // teardown
+
+   // the lookup itself can be a constant expression
+   void test_find_compileTime()
+   {  // setup
+      static constexpr custom::array<Header, 3> methods =
+         {{ { "GET", 1 }, { "PUT", 2 }, { "POST", 3 } }};
+      static constexpr auto m = custom::make_static_map(methods);
+      // exercise
+      constexpr int put = m.at("PUT");
+      constexpr bool hasPatch = m.contains("PATCH");
+      // verify
+      static_assert(put == 2, "lookup at compile time");
+      static_assert(!hasPatch, "lookup at compile time");
+      assertUnit(put == 2);
+      assertUnit(!hasPatch);
+   }  // teardown
+
+   // at a key that is not there
+   void test_at_error()
+   {  // setup
+      custom::array<std::pair<int, int>, 2> items = {{ { 1, 10 }, { 2, 20 } }};
+      custom::static_map<int, int, 2> m(items);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(3);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   // dispatch to a handler by command name
+   static int add(int lhs, int rhs)      { return lhs + rhs; }
+   static int subtract(int lhs, int rhs) { return lhs - rhs; }
+   static int multiply(int lhs, int rhs) { return lhs * rhs; }
+   void test_find_handlers()
+   {  // setup
+      typedef int (*Handler)(int, int);
+      static constexpr custom::array<std::pair<std::string_view, Handler>, 3> commands =
+         {{ { "add", &add }, { "sub", &subtract }, { "mul", &multiply } }};
+      constexpr auto m = custom::make_static_map(commands);
+      // exercise
+      int sum        = (*m.find("add"))(6, 3);
+      int difference = (*m.find("sub"))(6, 3);
+      int product    = (*m.find("mul"))(6, 3);
+      // verify
+      assertUnit(sum == 9);
+      assertUnit(difference == 3);
+      assertUnit(product == 18);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,564 @@
+/***********************************************************************
+ * Header:
+ *    TEST STATIC VECTOR
+ * Summary:
+ *    Unit tests for static_vector
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <stdexcept>       // for std::length_error and std::runtime_error
+#include "staticVector.h"  // class under test
+#include "unitTest.h"      // unit test baseclass
+#include "spy.h"           // spy is a mock class to monitor the class under test
+
+// custom::stack includes the vector.h that sits beside it; only test
+// static_vector as its storage when that file is there
+#if __has_include("../Stack/vector.h")
+#include "../Stack/stack.h"
+#define TEST_STATIC_VECTOR_STACK
+#endif
+
+/***********************************************
+ * TEST STATIC VECTOR
+ * Unit tests for the static_vector class
+ ***********************************************/
+class TestStaticVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sizeValue();
+      test_construct_initializerList();
+      test_construct_copy();
+      test_construct_move();
+      test_construct_tooMany();
+      test_construct_throws();
+      test_destructor();
+
+      // Assign
+      test_assign_copyShrink();
+      test_assign_copyGrow();
+      test_swap_differentSizes();
+
+      // Insert
+      test_pushBack_copy();
+      test_pushBack_move();
+      test_pushBack_full();
+      test_emplaceBack();
+      test_insert_middle();
+      test_insert_end();
+
+      // Remove
+      test_popBack();
+      test_erase_middle();
+      test_erase_range();
+      test_clear();
+
+      // Access
+      test_at_error();
+      test_iterator_walk();
+
+#ifdef TEST_STATIC_VECTOR_STACK
+      // Stack
+      test_stack_pushPopTop();
+      test_stack_copySwap();
+#endif
+
+      report("StaticVector");
+   }
+
+   // a spy that refuses to be built from the value 67
+   struct Fragile
+   {
+      Fragile(const Spy & rhs) : spy(rhs)
+      {
+         if (rhs.get() == 67)
+            throw std::runtime_error("fragile");
+      }
+      Spy spy;
+   };
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty vector constructs no elements
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::static_vector<Spy, 4> v;
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(v.size() == 0);
+      assertUnit(v.capacity() == 4);
+      assertUnit(v.empty());
+   }  // teardown
+
+   // num copies of one value
+   void test_construct_sizeValue()
+   {  // setup
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      custom::static_vector<Spy, 4> v(3, s);
+      // verify
+      assertUnit(Spy::numCopy() == 3);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(v.size() == 3);
+      assertUnit(v[2] == Spy(99));
+   }  // teardown
+
+   // from an initializer list
+   void test_construct_initializerList()
+   {  // setup
+      // exercise
+      custom::static_vector<int, 8> v = { 26, 49, 67, 89 };
+      // verify
+      assertUnit(v.size() == 4);
+      assertUnit(v.front() == 26);
+      assertUnit(v.back() == 89);
+   }  // teardown
+
+   // copy every element
+   void test_construct_copy()
+   {  // setup
+      custom::static_vector<Spy, 4> vRHS;
+      setupStandardFixture(vRHS);
+      Spy::reset();
+      // exercise
+      custom::static_vector<Spy, 4> vLHS(vRHS);
+      // verify
+      assertUnit(Spy::numCopy() == 4);
+      assertUnit(Spy::numAssign() == 0);
+      assertStandardFixture(vLHS);
+      assertStandardFixture(vRHS);
+   }  // teardown
+
+   // move every element
+   void test_construct_move()
+   {  // setup
+      custom::static_vector<Spy, 4> vRHS;
+      setupStandardFixture(vRHS);
+      Spy::reset();
+      // exercise
+      custom::static_vector<Spy, 4> vLHS(std::move(vRHS));
+      // verify
+      assertUnit(Spy::numCopyMove() == 4);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(vRHS.empty());
+      assertStandardFixture(vLHS);
+   }  // teardown
+
+   // asking for more than N destroys what was already built
+   void test_construct_tooMany()
+   {  // setup
+      Spy s(99);
+      Spy::reset();
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::static_vector<Spy, 4> v(5, s);
+      }
+      catch (const std::length_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(Spy::numCopy() == 4);
+      assertUnit(Spy::numDestructor() == 4);
+      assertUnit(Spy::numDelete() == 4);
+   }  // teardown
+
+   // an element that throws part way destroys the ones before it
+   void test_construct_throws()
+   {  // setup
+      Spy s[4] = { 26, 49, 67, 89 };
+      Spy::reset();
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::static_vector<Fragile, 4> v(s, s + 4);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(Spy::numAlloc() > 0);
+      assertUnit(Spy::numAlloc() == Spy::numDelete());
+   }  // teardown
+
+   // only the constructed elements are destroyed
+   void test_destructor()
+   {  // setup
+      {
+         custom::static_vector<Spy, 8> v;
+         setupStandardFixture(v);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 4);
+      assertUnit(Spy::numDelete() == 4);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign a shorter vector
+   void test_assign_copyShrink()
+   {  // setup
+      custom::static_vector<Spy, 4> vLHS;
+      setupStandardFixture(vLHS);
+      custom::static_vector<Spy, 4> vRHS(2, Spy(11));
+      Spy::reset();
+      // exercise
+      vLHS = vRHS;
+      // verify
+      assertUnit(Spy::numAssign() == 2);
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(vLHS.size() == 2);
+      assertUnit(vLHS[1] == Spy(11));
+   }  // teardown
+
+   // assign a longer vector
+   void test_assign_copyGrow()
+   {  // setup
+      custom::static_vector<Spy, 4> vLHS(1, Spy(11));
+      custom::static_vector<Spy, 4> vRHS;
+      setupStandardFixture(vRHS);
+      Spy::reset();
+      // exercise
+      vLHS = vRHS;
+      // verify
+      assertUnit(Spy::numAssign() == 1);
+      assertUnit(Spy::numCopy() == 3);
+      assertStandardFixture(vLHS);
+   }  // teardown
+
+   // swap vectors of different sizes
+   void test_swap_differentSizes()
+   {  // setup
+      custom::static_vector<Spy, 4> vLHS;
+      setupStandardFixture(vLHS);
+      custom::static_vector<Spy, 4> vRHS(1, Spy(11));
+      Spy::reset();
+      // exercise
+      vLHS.swap(vRHS);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(vLHS.size() == 1);
+      assertUnit(vLHS[0] == Spy(11));
+      assertStandardFixture(vRHS);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push a copy onto the end
+   void test_pushBack_copy()
+   {  // setup
+      custom::static_vector<Spy, 4> v;
+      Spy s(26);
+      Spy::reset();
+      // exercise
+      v.push_back(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(v.size() == 1);
+      assertUnit(v[0] == Spy(26));
+   }  // teardown
+
+   // move onto the end
+   void test_pushBack_move()
+   {  // setup
+      custom::static_vector<Spy, 4> v;
+      Spy s(26);
+      Spy::reset();
+      // exercise
+      v.push_back(std::move(s));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(s.empty());
+      assertUnit(v[0] == Spy(26));
+   }  // teardown
+
+   // push onto a full vector
+   void test_pushBack_full()
+   {  // setup
+      custom::static_vector<int, 2> v = { 1, 2 };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         v.push_back(3);
+      }
+      catch (const std::length_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(v.full());
+      assertUnit(v.size() == 2);
+   }  // teardown
+
+   // construct in place
+   void test_emplaceBack()
+   {  // setup
+      custom::static_vector<Spy, 4> v;
+      Spy::reset();
+      // exercise
+      Spy & s = v.emplace_back(67);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(&s == &v.back());
+      assertUnit(s == Spy(67));
+   }  // teardown
+
+   // insert in front of an element
+   void test_insert_middle()
+   {  // setup
+      custom::static_vector<int, 8> v = { 26, 67, 89 };
+      // exercise
+      custom::static_vector<int, 8>::iterator it = v.insert(v.begin() + 1, 49);
+      // verify
+      assertUnit(it == v.begin() + 1);
+      assertUnit(v.size() == 4);
+      assertUnit(v[0] == 26);
+      assertUnit(v[1] == 49);
+      assertUnit(v[2] == 67);
+      assertUnit(v[3] == 89);
+   }  // teardown
+
+   // insert at the end
+   void test_insert_end()
+   {  // setup
+      custom::static_vector<Spy, 4> v;
+      Spy::reset();
+      // exercise
+      v.insert(v.end(), Spy(26));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(v.size() == 1);
+      assertUnit(v[0] == Spy(26));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // remove the last element
+   void test_popBack()
+   {  // setup
+      custom::static_vector<Spy, 4> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(Spy::numDelete() == 1);
+      assertUnit(v.size() == 3);
+      assertUnit(v.back() == Spy(67));
+   }  // teardown
+
+   // remove from the middle
+   void test_erase_middle()
+   {  // setup
+      custom::static_vector<Spy, 4> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      custom::static_vector<Spy, 4>::iterator it = v.erase(v.begin() + 1);
+      // verify
+      assertUnit(Spy::numAssignMove() == 2);
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(*it == Spy(67));
+      assertUnit(v.size() == 3);
+      assertUnit(v[0] == Spy(26));
+      assertUnit(v[2] == Spy(89));
+   }  // teardown
+
+   // remove a range
+   void test_erase_range()
+   {  // setup
+      custom::static_vector<int, 8> v = { 1, 2, 3, 4, 5, 6 };
+      // exercise
+      custom::static_vector<int, 8>::iterator it = v.erase(v.begin() + 1, v.begin() + 4);
+      // verify
+      assertUnit(*it == 5);
+      assertUnit(v.size() == 3);
+      assertUnit(v[0] == 1);
+      assertUnit(v[1] == 5);
+      assertUnit(v[2] == 6);
+   }  // teardown
+
+   // remove everything
+   void test_clear()
+   {  // setup
+      custom::static_vector<Spy, 4> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 4);
+      assertUnit(v.empty());
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // at past the constructed elements
+   void test_at_error()
+   {  // setup
+      custom::static_vector<int, 8> v = { 1, 2 };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         v.at(2);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(v.at(1) == 2);
+   }  // teardown
+
+   // walk the elements with an iterator
+   void test_iterator_walk()
+   {  // setup
+      custom::static_vector<int, 8> v = { 26, 49, 67, 89 };
+      int total = 0;
+      // exercise
+      for (int value : v)
+         total += value;
+      // verify
+      assertUnit(total == 26 + 49 + 67 + 89);
+      assertUnit(v.end() - v.begin() == 4);
+   }  // teardown
+
+#ifdef TEST_STATIC_VECTOR_STACK
+   /***************************************
+    * STACK
+    ***************************************/
+
+   // a stack that never allocates
+   void test_stack_pushPopTop()
+   {  // setup
+      custom::stack<Spy, custom::static_vector<Spy, 4>> s;
+      Spy::reset();
+      bool thrown = false;
+      // exercise
+      for (int i = 1; i <= 4; i++)
+         s.push(Spy(i));
+      try
+      {
+         s.push(Spy(5));
+      }
+      catch (const std::length_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(s.size() == 4);
+      assertUnit(s.top() == Spy(4));
+      s.pop();
+      s.pop();
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == Spy(2));
+      s.pop();
+      s.pop();
+      assertUnit(s.empty());
+      assertUnit(Spy::numAlloc() == Spy::numDelete());
+   }  // teardown
+
+   // copy and swap keep the static_vector storage
+   void test_stack_copySwap()
+   {  // setup
+      typedef custom::stack<int, custom::static_vector<int, 4>> Stack;
+      Stack a;
+      a.push(26);
+      a.push(49);
+      Stack b;
+      b.push(67);
+      // exercise
+      Stack copy(a);
+      a.swap(b);
+      // verify
+      assertUnit(a.size() == 1 && a.top() == 67);
+      assertUnit(b.size() == 2 && b.top() == 49);
+      assertUnit(copy.size() == 2 && copy.top() == 49);
+      copy = a;
+      assertUnit(copy.size() == 1 && copy.top() == 67);
+   }  // teardown
+#endif // TEST_STATIC_VECTOR_STACK
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *      0    1    2    3
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |
+    *    +----+----+----+----+
+    *************************************************************/
+   template <int N>
+   void setupStandardFixture(custom::static_vector<Spy, N> & v)
+   {
+      v.clear();
+      v.push_back(Spy(26));
+      v.push_back(Spy(49));
+      v.push_back(Spy(67));
+      v.push_back(Spy(89));
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE PARAMETERS
+    *************************************************************/
+   template <int N>
+   void assertStandardFixtureParameters(const custom::static_vector<Spy, N> & v,
+                                        int line, const char * function)
+   {
+      assertIndirect(v.size() == 4);
+      assertIndirect(v[0] == Spy(26));
+      assertIndirect(v[1] == Spy(49));
+      assertIndirect(v[2] == Spy(67));
+      assertIndirect(v[3] == Spy(89));
+   }
+};
+
+#endif // DEBUG
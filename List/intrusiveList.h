@@ -0,0 +1,466 @@
+/***********************************************************************
+ * Header:
+ *    INTRUSIVE LIST
+ * Summary:
+ *    A list of objects that live somewhere else, linked through a
+ *    hook inside each object, so nothing is copied or allocated
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        list_hook                : the links, a member of the object
+ *        intrusive_list           : a list of the objects holding a hook
+ *        intrusive_list::iterator : an iterator through it
+ *
+ *    The list owns none of its objects. push, insert and erase only
+ *    rewrite links, with the same meaning as in custom::list: insert
+ *    goes before the iterator and returns the new item, erase returns
+ *    the item after. An object can be in as many lists as it has
+ *    hooks, and is in at most one list per hook.
+ *
+ *    Hooks are safe: a hook unlinks itself when its object is
+ *    destroyed, and a copied object starts out in no list. Because
+ *    an object can leave without the list seeing it, size() counts.
+ *
+ *       struct Connection
+ *       {
+ *          int socket;
+ *          custom::list_hook idle;
+ *       };
+ *       custom::intrusive_list<Connection, &Connection::idle> idleList;
+ *       idleList.push_back(pool[3]);
+ *       ...
+ *       pool[3].idle.unlink();             // O(1), no list needed
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+#include <cstddef>     // for size_t and std::ptrdiff_t
+#include <utility>     // for std::move
+
+class TestIntrusiveList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * LIST HOOK
+ * The links of one object in one intrusive list
+ **************************************************/
+class list_hook
+{
+   friend class ::TestIntrusiveList; // give unit tests access to the privates
+   template <typename T, list_hook T::*Hook>
+   friend class intrusive_list;
+public:
+   list_hook() : pNext(nullptr), pPrev(nullptr) { }
+
+   // a copy of an object is not in its lists
+   list_hook(const list_hook &) : pNext(nullptr), pPrev(nullptr) { }
+   list_hook & operator = (const list_hook &) { return *this; }
+
+   ~list_hook()
+   {
+      unlink();
+   }
+
+   bool is_linked() const { return pNext != nullptr; }
+
+   // Leave whatever list this is in
+   void unlink()
+   {
+      if (pNext)
+      {
+         pPrev->pNext = pNext;
+         pNext->pPrev = pPrev;
+         pNext = pPrev = nullptr;
+      }
+   }
+
+private:
+   // join the chain just before pPos
+   void linkBefore(list_hook * pPos)
+   {
+      pNext = pPos;
+      pPrev = pPos->pPrev;
+      pPrev->pNext = this;
+      pPos->pPrev = this;
+   }
+
+   list_hook * pNext;   // the next hook, or the list's root after the last
+   list_hook * pPrev;   // the previous hook, or the root before the first
+};
+
+/**************************************************
+ * INTRUSIVE LIST
+ * A circular chain of hooks through a root hook
+ * of the list's own, so no link is ever null
+ **************************************************/
+template <typename T, list_hook T::*Hook>
+class intrusive_list
+{
+   friend class ::TestIntrusiveList; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   intrusive_list()
+   {
+      root.pNext = root.pPrev = &root;
+   }
+   intrusive_list(intrusive_list && rhs)
+   {
+      root.pNext = root.pPrev = &root;
+      take(rhs);
+   }
+   intrusive_list(const intrusive_list & rhs) = delete;
+
+   // the objects stay where they are, linked to nothing
+   ~intrusive_list()
+   {
+      clear();
+      root.pNext = root.pPrev = nullptr;
+   }
+
+   //
+   // Assign
+   //
+
+   intrusive_list & operator = (intrusive_list && rhs)
+   {
+      if (this != &rhs)
+      {
+         clear();
+         take(rhs);
+      }
+      return *this;
+   }
+   intrusive_list & operator = (const intrusive_list & rhs) = delete;
+
+   void swap(intrusive_list & rhs)
+   {
+      intrusive_list temp(std::move(rhs));
+      rhs.take(*this);
+      take(temp);
+   }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin()  { return iterator(root.pNext); }
+   iterator rbegin() { return iterator(root.pPrev); }
+   iterator end()    { return iterator(&root);      }
+
+   // where an object already in this list is, without looking for it
+   static iterator iterator_to(T & value) { return iterator(&(value.*Hook)); }
+
+   //
+   // Access
+   //
+
+   T & front();
+   T & back();
+
+   //
+   // Insert
+   //
+
+   void push_front(T & value) { insert(begin(), value); }
+   void push_back (T & value) { insert(end(),   value); }
+   iterator insert(iterator it, T & value);
+
+   //
+   // Remove
+   //
+
+   void pop_back()  { if (!empty()) erase(rbegin()); }
+   void pop_front() { if (!empty()) erase(begin());  }
+   void clear();
+   iterator erase(iterator it);
+   iterator erase(iterator first, iterator last);
+   template <class Predicate>
+   size_t remove_if(Predicate pred);
+
+   // take an object out of this list, or any list of this kind
+   static void unlink(T & value) { (value.*Hook).unlink(); }
+
+   //
+   // Relink
+   //
+
+   void splice(iterator pos, intrusive_list & rhs);
+   void splice(iterator pos, intrusive_list & rhs, iterator it);
+
+   //
+   // Status
+   //
+
+   bool empty() const { return root.pNext == &root; }
+   size_t size() const;
+
+private:
+   // the object a hook belongs to
+   static T * owner(list_hook * pHook)
+   {
+      return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(pHook) - hookOffset());
+   }
+
+   // how far into a T its hook sits, found from a T-sized stand-in
+   static std::ptrdiff_t hookOffset()
+   {
+      alignas(T) static unsigned char probe[sizeof(T)];
+      T * p = reinterpret_cast<T *>(probe);
+      return reinterpret_cast<unsigned char *>(&(p->*Hook)) - probe;
+   }
+
+   // move every object of rhs onto the end of this list
+   void take(intrusive_list & rhs)
+   {
+      splice(end(), rhs);
+   }
+
+   list_hook root;   // before the first hook and after the last
+};
+
+/*************************************************
+ * INTRUSIVE LIST ITERATOR
+ * An iterator through the hooks, handing back the
+ * objects that hold them
+ *************************************************/
+template <typename T, list_hook T::*Hook>
+class intrusive_list<T, Hook>::iterator
+{
+   friend class ::TestIntrusiveList; // give unit tests access to the privates
+   friend class intrusive_list;
+public:
+   iterator() : p(nullptr) { }
+   iterator(list_hook * p) : p(p) { }
+
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   T & operator * () { return *owner(p); }
+   T * operator -> () { return owner(p); }
+
+   iterator & operator ++ ()
+   {
+      p = p->pNext;
+      return *this;
+   }
+   iterator operator ++ (int)
+   {
+      iterator temp = *this;
+      p = p->pNext;
+      return temp;
+   }
+   iterator & operator -- ()
+   {
+      p = p->pPrev;
+      return *this;
+   }
+   iterator operator -- (int)
+   {
+      iterator temp = *this;
+      p = p->pPrev;
+      return temp;
+   }
+
+private:
+   list_hook * p;   // the hook of the current object, or the root at the end
+};
+
+/*********************************************
+ * INTRUSIVE LIST :: FRONT
+ * The first object
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, list_hook T::*Hook>
+T & intrusive_list <T, Hook> :: front()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+   return *owner(root.pNext);
+}
+
+/*********************************************
+ * INTRUSIVE LIST :: BACK
+ * The last object
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, list_hook T::*Hook>
+T & intrusive_list <T, Hook> :: back()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+   return *owner(root.pPrev);
+}
+
+/******************************************
+ * INTRUSIVE LIST :: INSERT
+ * link an object in before it. An object already
+ * in a list through this hook cannot be.
+ *     INPUT  : where, and the object
+ *     OUTPUT : iterator to the object
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, list_hook T::*Hook>
+typename intrusive_list <T, Hook> :: iterator
+intrusive_list <T, Hook> :: insert(iterator it, T & value)
+{
+   list_hook & hook = value.*Hook;
+   if (hook.is_linked())
+      throw "ERROR: the object is already in a list";
+   hook.linkBefore(it.p);
+   return iterator(&hook);
+}
+
+/******************************************
+ * INTRUSIVE LIST :: ERASE
+ * unlink an object, leaving the object itself alone
+ *     INPUT  : an iterator to the object
+ *     OUTPUT : iterator to the object after it
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, list_hook T::*Hook>
+typename intrusive_list <T, Hook> :: iterator
+intrusive_list <T, Hook> :: erase(iterator it)
+{
+   if (it.p == &root)
+      return end();
+   list_hook * pNext = it.p->pNext;
+   it.p->unlink();
+   return iterator(pNext);
+}
+
+/******************************************
+ * INTRUSIVE LIST :: ERASE
+ * unlink the objects from first up to, not including, last
+ *     INPUT  : the range of objects
+ *     OUTPUT : last
+ *     COST   : O(n) with respect to the objects unlinked
+ ******************************************/
+template <typename T, list_hook T::*Hook>
+typename intrusive_list <T, Hook> :: iterator
+intrusive_list <T, Hook> :: erase(iterator first, iterator last)
+{
+   while (first != last)
+      first = erase(first);
+   return last;
+}
+
+/******************************************
+ * INTRUSIVE LIST :: REMOVE IF
+ * unlink every object pred is true for
+ *     INPUT  : pred(object) is true for the objects to go
+ *     OUTPUT : how many were unlinked
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, list_hook T::*Hook>
+template <class Predicate>
+size_t intrusive_list <T, Hook> :: remove_if(Predicate pred)
+{
+   size_t numRemoved = 0;
+   for (iterator it = begin(); it != end(); )
+   {
+      if (pred(*it))
+      {
+         it = erase(it);
+         numRemoved++;
+      }
+      else
+         ++it;
+   }
+   return numRemoved;
+}
+
+/**********************************************
+ * INTRUSIVE LIST :: CLEAR
+ * Unlink every object
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, list_hook T::*Hook>
+void intrusive_list <T, Hook> :: clear()
+{
+   list_hook * p = root.pNext;
+   while (p != &root)
+   {
+      list_hook * pNext = p->pNext;
+      p->pNext = p->pPrev = nullptr;
+      p = pNext;
+   }
+   root.pNext = root.pPrev = &root;
+}
+
+/******************************************
+ * INTRUSIVE LIST :: SPLICE
+ * move every object of rhs in before pos
+ *     INPUT  : where, and the list to empty
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, list_hook T::*Hook>
+void intrusive_list <T, Hook> :: splice(iterator pos, intrusive_list & rhs)
+{
+   if (this == &rhs || rhs.empty())
+      return;
+
+   list_hook * pFirst = rhs.root.pNext;
+   list_hook * pLast = rhs.root.pPrev;
+   rhs.root.pNext = rhs.root.pPrev = &rhs.root;
+
+   pFirst->pPrev = pos.p->pPrev;
+   pFirst->pPrev->pNext = pFirst;
+   pLast->pNext = pos.p;
+   pos.p->pPrev = pLast;
+}
+
+/******************************************
+ * INTRUSIVE LIST :: SPLICE
+ * move one object of rhs in before pos. rhs may
+ * be this list.
+ *     INPUT  : where, the list it comes from, and the object
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, list_hook T::*Hook>
+void intrusive_list <T, Hook> :: splice(iterator pos, intrusive_list & rhs, iterator it)
+{
+   if (it.p == &rhs.root || it.p == pos.p || it.p->pNext == pos.p)
+      return;
+   it.p->unlink();
+   it.p->linkBefore(pos.p);
+}
+
+/**********************************************
+ * INTRUSIVE LIST :: SIZE
+ * Count the objects. Hooks can leave on their own,
+ * so there is no count to keep.
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, list_hook T::*Hook>
+size_t intrusive_list <T, Hook> :: size() const
+{
+   size_t num = 0;
+   for (const list_hook * p = root.pNext; p != &root; p = p->pNext)
+      num++;
+   return num;
+}
+
+/**********************************************
+ * SWAP
+ * Exchange the objects of two intrusive lists
+ *********************************************/
+template <typename T, list_hook T::*Hook>
+void swap(intrusive_list <T, Hook> & lhs, intrusive_list <T, Hook> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+}; // namespace custom
@@ -19,9 +19,11 @@
 
 #pragma once
 #include <cassert>     // for ASSERT
+#include <functional>  // for std::less and std::equal_to
 #include <iostream>    // for nullptr
 #include <new>         // std::bad_alloc
-#include <memory>      // for std::allocator
+#include <memory>      // for std::allocator and std::allocator_traits
+#include <utility>     // for std::move, std::forward, std::swap and std::in_place
 
 class TestList; // forward declaration for unit tests
 class TestHash; // forward declaration for hash used later
@@ -46,44 +48,20 @@ public:
    //
 
    list(const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr){ }
-   list(list <T, A> & rhs, const A& a = A()): alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+   list(const list <T, A> & rhs) :
+      alloc(NodeTraits::select_on_container_copy_construction(rhs.alloc)),
+      numElements(0), pHead(nullptr), pTail(nullptr)
    {
-      // Check if the source list is empty
-      if (rhs.pHead == nullptr)
-      {
-         // If it's empty, we do nothing, as we've initialized numElements to 0 and pHead/pTail to nullptr.
-         return;
-      }
-      // Create a temporary pointer for traversing the source list
-      Node* current = rhs.pHead;
-       
-      // Loop through the source list and copy each node
-      while (current != nullptr)
-      {
-         // Create a new node using the copy constructor of T
-         Node* newNode = new Node(current->data);
-         
-         // If the destination list is empty, set head and tail to the new node
-         if (pHead == nullptr)
-         {
-            pHead = newNode;
-            pTail = newNode;
-         }
-         else
-         {
-            // Link the new node to the end of the list
-            pTail->pNext = newNode;
-            newNode->pPrev = pTail;
-            pTail = newNode; // Update the tail to the new node
-         }
-
-         // Move to the next node in the source list
-            current = current->pNext;
-      }
-         // Set the number of elements in the destination list
-         numElements = rhs.numElements;
+      for (Node * p = rhs.pHead; p; p = p->pNext)
+         push_back(p->data);
+   }
+   list(const list <T, A> & rhs, const A& a) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+   {
+      for (Node * p = rhs.pHead; p; p = p->pNext)
+         push_back(p->data);
    }
-   list(list <T, A>&& rhs, const A& a = A());
+   list(list <T, A>&& rhs);
+   list(list <T, A>&& rhs, const A& a);
    list(size_t num, const T & t, const A& a = A());
    list(size_t num, const A& a = A());
    list(const std::initializer_list<T>& il, const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
@@ -126,9 +104,16 @@ public:
       std::swap(this->pTail, rhs.pTail);
       std::swap(this->numElements, rhs.numElements);
 
-      // Step 3: (Optional) If you have any additional state to swap, do it here
+      // Step 3: The nodes follow the allocator that made them, if it may move
+      if (NodeTraits::propagate_on_container_swap::value)
+      {
+         using std::swap;
+         swap(alloc, rhs.alloc);
+      }
    }
 
+   A get_allocator() const { return A(alloc); }
+
 
    //
    // Iterator
@@ -156,6 +141,12 @@ public:
    void push_back (      T && data);
    iterator insert(iterator it, const T &  data);
    iterator insert(iterator it,       T && data);
+   template <class ... Args>
+   iterator emplace(iterator it, Args && ... args);
+   template <class ... Args>
+   T & emplace_back(Args && ... args)  { return *emplace(end(), std::forward<Args>(args)...);   }
+   template <class ... Args>
+   T & emplace_front(Args && ... args) { return *emplace(begin(), std::forward<Args>(args)...); }
 
    //
    // Remove
@@ -165,6 +156,36 @@ public:
    void pop_front();
    void clear();
    iterator erase(const iterator & it);
+   iterator erase(iterator first, iterator last);
+   size_t remove(const T & data)
+   {
+      return remove_if([&data](const T & item) { return item == data; });
+   }
+   template <class Predicate>
+   size_t remove_if(Predicate pred);
+   size_t unique() { return unique(std::equal_to<T>()); }
+   template <class BinaryPredicate>
+   size_t unique(BinaryPredicate same);
+
+   //
+   // Relink
+   //
+
+   void splice(iterator pos, list <T, A> & rhs);
+   void splice(iterator pos, list <T, A> & rhs, iterator it);
+   void splice(iterator pos, list <T, A> & rhs, iterator first, iterator last);
+   void merge(list <T, A> & rhs) { merge(rhs, std::less<T>()); }
+   template <class Compare>
+   void merge(list <T, A> & rhs, Compare compare);
+   void reverse();
+
+   //
+   // Sort
+   //
+
+   void sort() { sort(std::less<T>()); }
+   template <class Compare>
+   void sort(Compare compare);
 
    //
    // Status
@@ -177,8 +198,22 @@ private:
    // nested linked list class
    class Node;
 
+   // the allocator A, rebound to hand out whole nodes instead of T's
+   typedef typename std::allocator_traits<A>::template rebind_alloc<Node> NodeAlloc;
+   typedef std::allocator_traits<NodeAlloc> NodeTraits;
+
+   // allocate and construct a node, or destroy and deallocate one
+   template <class ... Args>
+   Node * createNode(Args && ... args);
+   void destroyNode(Node * pNode);
+
+   // take the nodes pFirst through pLast out of the chain, or put them
+   // back in before pPos (the end if pPos is null); neither counts them
+   void unlinkNodes(Node * pFirst, Node * pLast);
+   void linkNodes(Node * pPos, Node * pFirst, Node * pLast);
+
    // member variables
-   A    alloc;         // use alloacator for memory allocation
+   NodeAlloc alloc;    // every node is allocated and built through this
    size_t numElements; // though we could count, it is faster to keep a variable
    Node * pHead;       // pointer to the beginning of the list
    Node * pTail;       // pointer to the ending of the list
@@ -201,6 +236,8 @@ public:
    Node() : pNext(nullptr), pPrev(nullptr) {}
    Node(const T& data) : data(data), pNext(nullptr), pPrev(nullptr) {}
    Node(T&& data) : data(std::move(data)), pNext(nullptr), pPrev(nullptr) {}
+   template <class ... Args>
+   Node(std::in_place_t, Args&& ... args) : data(std::forward<Args>(args)...), pNext(nullptr), pPrev(nullptr) {}
 };
 
 
@@ -288,7 +325,7 @@ list <T, A> :: list(size_t num, const T& t, const A& a): alloc(a), numElements(0
 {
    for (size_t i = 0; i < num; ++i)
    {
-      push_back(t); // Ensure copy constructor is used
+      emplace_back(t); // Ensure copy constructor is used
    }
 }
 
@@ -302,22 +339,43 @@ list<T, A>::list(size_t num, const A& a) : alloc(a), numElements(0), pHead(nullp
 {
    for (size_t i = 0; i < num; ++i)
    {
-      push_back(T()); // Calls the default constructor for T (in this case, Spy)
+      emplace_back(); // Calls the default constructor for T (in this case, Spy), in the node
    }
 }
 
 /*****************************************
  * LIST :: MOVE constructors
- * Steal the values from the RHS
+ * Steal the values from the RHS, along with the
+ * allocator that will have to free them
  ****************************************/
 template <typename T, typename A>
-list <T, A> ::list(list <T, A>&& rhs, const A& a) :
-   numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail), alloc(a)
+list <T, A> ::list(list <T, A>&& rhs) :
+   alloc(std::move(rhs.alloc)), numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
 {
    rhs.pHead = rhs.pTail = nullptr;
    rhs.numElements = 0;
 }
 
+/*****************************************
+ * LIST :: MOVE constructors
+ * Steal the nodes if our allocator can free them;
+ * otherwise move the values one at a time into
+ * nodes of our own
+ ****************************************/
+template <typename T, typename A>
+list <T, A> ::list(list <T, A>&& rhs, const A& a) :
+   alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+{
+   if (alloc == rhs.alloc)
+   {
+      swap(rhs);
+      return;
+   }
+   for (Node * p = rhs.pHead; p; p = p->pNext)
+      push_back(std::move(p->data));
+   rhs.clear();
+}
+
 /**********************************************
  * LIST :: assignment operator - MOVE
  * Copy one list onto another
@@ -330,8 +388,28 @@ list<T, A>& list<T, A>::operator=(list<T, A>&& rhs)
 {
    if (this != &rhs)
    { // Avoid self-assignment
-      clear(); // Clear current elements
-      swap(rhs);
+      clear(); // Clear current elements with the allocator that made them
+
+      if (NodeTraits::propagate_on_container_move_assignment::value)
+      {
+         alloc = std::move(rhs.alloc);
+         std::swap(pHead, rhs.pHead);
+         std::swap(pTail, rhs.pTail);
+         std::swap(numElements, rhs.numElements);
+      }
+      else if (alloc == rhs.alloc)
+      {
+         std::swap(pHead, rhs.pHead);
+         std::swap(pTail, rhs.pTail);
+         std::swap(numElements, rhs.numElements);
+      }
+      else
+      {
+         // our allocator cannot free their nodes, so move the values across
+         for (Node * p = rhs.pHead; p; p = p->pNext)
+            push_back(std::move(p->data));
+         rhs.clear();
+      }
    }
    return *this;
 }
@@ -350,6 +428,15 @@ list<T, A>& list<T, A>::operator=( list<T, A>& rhs)
 {
    if (this != &rhs)
    { // Avoid self-assignment
+      // Step 0: Take the RHS's allocator if it propagates. Our nodes must
+      //         be freed by the allocator that made them, so they go first.
+      if (NodeTraits::propagate_on_container_copy_assignment::value)
+      {
+         if (alloc != rhs.alloc)
+            clear();
+         alloc = rhs.alloc;
+      }
+
       // Step 1: Handle empty case
       if (rhs.empty())
       {
@@ -431,6 +518,46 @@ list<T, A>& list<T, A>::operator=(const std::initializer_list<T>& il)
 
 
 
+/**********************************************
+ * LIST :: CREATE NODE
+ * Get room for one node from the allocator and
+ * build it there. If T's constructor throws, the
+ * room goes back before the exception leaves.
+ *     INPUT  : the arguments for T's constructor
+ *     OUTPUT : the new node, linked to nothing
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+template <class ... Args>
+typename list <T, A> :: Node * list <T, A> :: createNode(Args && ... args)
+{
+   Node * pNode = NodeTraits::allocate(alloc, 1);
+   try
+   {
+      NodeTraits::construct(alloc, pNode, std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      NodeTraits::deallocate(alloc, pNode, 1);
+      throw;
+   }
+   return pNode;
+}
+
+/**********************************************
+ * LIST :: DESTROY NODE
+ * Destroy one node and give its room back to the
+ * allocator that it came from
+ *     INPUT  : the node, already unlinked
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+void list <T, A> :: destroyNode(Node * pNode)
+{
+   NodeTraits::destroy(alloc, pNode);
+   NodeTraits::deallocate(alloc, pNode, 1);
+}
+
 /**********************************************
  * LIST :: CLEAR
  * Remove all the items currently in the linked list
@@ -457,7 +584,7 @@ void list <T, A> :: clear()
 template <typename T, typename A>
 void list<T, A>::push_back(const T& data)
 {
-   Node* newNode = new Node(data); // Copy constructor
+   Node* newNode = createNode(data); // Copy constructor
    if (pTail)
    {
       pTail->pNext = newNode; // Link new node after tail
@@ -474,7 +601,7 @@ void list<T, A>::push_back(const T& data)
 template <typename T, typename A>
 void list<T, A>::push_back(T&& data)
 {
-   Node* newNode = new Node(std::move(data)); // Move constructor
+   Node* newNode = createNode(std::move(data)); // Move constructor
    if (pTail)
    {
       pTail->pNext = newNode; // Link new node after tail
@@ -501,7 +628,7 @@ void list<T, A>::push_back(T&& data)
 template <typename T, typename A>
 void list<T, A>::push_front(const T& data)
 {
-   Node* newNode = new Node(data); // Use the copy constructor to create a new node
+   Node* newNode = createNode(data); // Use the copy constructor to create a new node
    
    if (pHead)
    {
@@ -520,7 +647,7 @@ void list<T, A>::push_front(const T& data)
 template <typename T, typename A>
 void list<T, A>::push_front(T&& data)
 {
-   Node* newNode = new Node(std::move(data)); // Use the move constructor to create a new node
+   Node* newNode = createNode(std::move(data)); // Use the move constructor to create a new node
 
     if (pHead)
    {
@@ -554,7 +681,7 @@ void list <T, A> ::pop_back()
       pTail = pTail->pPrev;
       if (pTail) pTail->pNext = nullptr;
       else pHead = nullptr;
-      delete temp;
+      destroyNode(temp);
       --numElements;
    }
 }
@@ -575,7 +702,7 @@ void list <T, A> ::pop_front()
       pHead = pHead->pNext;
       if (pHead) pHead->pPrev = nullptr;
       else pTail = nullptr;
-      delete temp;
+      destroyNode(temp);
       --numElements;
    }
 }
@@ -662,7 +789,7 @@ typename list <T, A> :: iterator  list <T, A> :: erase(const list <T, A> :: iter
    numElements--;
    
    // Delete the node
-   delete nodeToDelete;
+   destroyNode(nodeToDelete);
    
    // Return an iterator to the next node, or end if there was none
    return (nextNode != nullptr) ? iterator(nextNode) : end();
@@ -682,7 +809,7 @@ typename list <T, A> :: iterator list <T, A> :: insert(list <T, A> :: iterator i
                                                 const T & data)
 {
    // Step 1: Create a new node
-   Node* newNode = new Node(data);      // Construct the node with data
+   Node* newNode = createNode(data); // Construct the node with data
 
    // Step 2: Handle insertion
    if (it.p == nullptr)
@@ -739,7 +866,7 @@ template <typename T, typename A>
 typename list<T, A>::iterator list<T, A>::insert(iterator it, T&& data)
 {
     // Step 1: Allocate memory for the new node
-   Node* newNode = new Node(std::move(data)); // Allocate space for one Node
+   Node* newNode = createNode(std::move(data)); // Allocate space for one Node
 
 
     // Step 3: Insert the new node into the list
@@ -786,6 +913,359 @@ typename list<T, A>::iterator list<T, A>::insert(iterator it, T&& data)
 }
 
 
+/**********************************************
+ * LIST :: UNLINK NODES
+ * Take a run of nodes out of the chain. The run's
+ * own links between its nodes are left alone.
+ *     INPUT  : the first and last node of the run
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+void list <T, A> :: unlinkNodes(Node * pFirst, Node * pLast)
+{
+   if (pFirst->pPrev)
+      pFirst->pPrev->pNext = pLast->pNext;
+   else
+      pHead = pLast->pNext;
+
+   if (pLast->pNext)
+      pLast->pNext->pPrev = pFirst->pPrev;
+   else
+      pTail = pFirst->pPrev;
+
+   pFirst->pPrev = nullptr;
+   pLast->pNext = nullptr;
+}
+
+/**********************************************
+ * LIST :: LINK NODES
+ * Put a run of nodes into the chain before pPos
+ *     INPUT  : the node to go before, null for the end,
+ *              and the first and last node of the run
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, typename A>
+void list <T, A> :: linkNodes(Node * pPos, Node * pFirst, Node * pLast)
+{
+   Node * pBefore = pPos ? pPos->pPrev : pTail;
+
+   pFirst->pPrev = pBefore;
+   if (pBefore)
+      pBefore->pNext = pFirst;
+   else
+      pHead = pFirst;
+
+   pLast->pNext = pPos;
+   if (pPos)
+      pPos->pPrev = pLast;
+   else
+      pTail = pLast;
+}
+
+/******************************************
+ * LIST :: ERASE
+ * remove the items from first up to, not including, last
+ *     INPUT  : the range of items to remove
+ *     OUTPUT : last
+ *     COST   : O(n) with respect to the items removed
+ ******************************************/
+template <typename T, typename A>
+typename list <T, A> :: iterator list <T, A> :: erase(iterator first, iterator last)
+{
+   while (first != last)
+      first = erase(first);
+   return last;
+}
+
+/******************************************
+ * LIST :: REMOVE IF
+ * remove every item pred is true for. The nodes are
+ * destroyed only after the walk, so remove() works
+ * even when its value is one of the items.
+ *     INPUT  : pred(item) is true for the items to go
+ *     OUTPUT : how many were removed
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+template <class Predicate>
+size_t list <T, A> :: remove_if(Predicate pred)
+{
+   size_t numRemoved = 0;
+   Node * pRemoved = nullptr;   // the removed nodes, linked through pNext
+   Node * p = pHead;
+   while (p)
+   {
+      Node * pNext = p->pNext;
+      if (pred(p->data))
+      {
+         unlinkNodes(p, p);
+         p->pNext = pRemoved;
+         pRemoved = p;
+         numRemoved++;
+      }
+      p = pNext;
+   }
+   numElements -= numRemoved;
+
+   while (pRemoved)
+   {
+      Node * pNext = pRemoved->pNext;
+      destroyNode(pRemoved);
+      pRemoved = pNext;
+   }
+   return numRemoved;
+}
+
+/******************************************
+ * LIST :: UNIQUE
+ * remove every item that is the same as the one
+ * before it, keeping the first of each run
+ *     INPUT  : same(a, b) is true when b repeats a
+ *     OUTPUT : how many were removed
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+template <class BinaryPredicate>
+size_t list <T, A> :: unique(BinaryPredicate same)
+{
+   size_t numRemoved = 0;
+   if (pHead)
+   {
+      Node * pKeep = pHead;
+      while (pKeep->pNext)
+      {
+         if (same(pKeep->data, pKeep->pNext->data))
+         {
+            erase(iterator(pKeep->pNext));
+            numRemoved++;
+         }
+         else
+            pKeep = pKeep->pNext;
+      }
+   }
+   return numRemoved;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move every node of rhs in before pos. The two
+ * lists must have equal allocators, since these
+ * nodes will be given back through ours.
+ *     INPUT  : where, and the list to empty
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A>
+void list <T, A> :: splice(iterator pos, list <T, A> & rhs)
+{
+   if (this == &rhs || rhs.pHead == nullptr)
+      return;
+
+   Node * pFirst = rhs.pHead;
+   Node * pLast = rhs.pTail;
+   linkNodes(pos.p, pFirst, pLast);
+   numElements += rhs.numElements;
+
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move one node of rhs in before pos. rhs may be
+ * this list.
+ *     INPUT  : where, the list it comes from, and the item
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A>
+void list <T, A> :: splice(iterator pos, list <T, A> & rhs, iterator it)
+{
+   Node * pNode = it.p;
+   if (pNode == nullptr)
+      return;
+   if (this == &rhs && (pNode == pos.p || pNode->pNext == pos.p))
+      return;
+
+   rhs.unlinkNodes(pNode, pNode);
+   rhs.numElements--;
+   linkNodes(pos.p, pNode, pNode);
+   numElements++;
+}
+
+/******************************************
+ * LIST :: SPLICE
+ * move the nodes of rhs from first up to, not
+ * including, last in before pos. rhs may be this
+ * list, as long as pos is not in the range.
+ *     INPUT  : where, the list they come from, and the range
+ *     COST   : O(1) within one list; between two, O(n) in the
+ *              size of the range to keep size() exact
+ ******************************************/
+template <typename T, typename A>
+void list <T, A> :: splice(iterator pos, list <T, A> & rhs, iterator first, iterator last)
+{
+   if (first == last || first.p == nullptr)
+      return;
+
+   Node * pFirst = first.p;
+   Node * pLast = last.p ? last.p->pPrev : rhs.pTail;
+   if (this == &rhs && (pFirst == pos.p || pLast->pNext == pos.p))
+      return;
+
+   if (this != &rhs)
+   {
+      size_t num = 1;
+      for (Node * p = pFirst; p != pLast; p = p->pNext)
+         num++;
+      rhs.numElements -= num;
+      numElements += num;
+   }
+
+   rhs.unlinkNodes(pFirst, pLast);
+   linkNodes(pos.p, pFirst, pLast);
+}
+
+/******************************************
+ * LIST :: MERGE
+ * move the nodes of a sorted rhs into this sorted
+ * list, keeping it sorted. On a tie ours go first.
+ *     INPUT  : the list to empty, and the order both are in
+ *     COST   : O(n + m)
+ ******************************************/
+template <typename T, typename A>
+template <class Compare>
+void list <T, A> :: merge(list <T, A> & rhs, Compare compare)
+{
+   if (this == &rhs)
+      return;
+
+   Node * p = pHead;
+   while (rhs.pHead)
+   {
+      // skip ours that go before rhs's first
+      while (p && !compare(rhs.pHead->data, p->data))
+         p = p->pNext;
+      if (p == nullptr)
+      {
+         splice(end(), rhs);
+         return;
+      }
+
+      // then move the run of rhs that goes before p in one piece
+      Node * pLast = rhs.pHead;
+      while (pLast->pNext && compare(pLast->pNext->data, p->data))
+         pLast = pLast->pNext;
+      splice(iterator(p), rhs, iterator(rhs.pHead), iterator(pLast->pNext));
+   }
+}
+
+/******************************************
+ * LIST :: REVERSE
+ * turn the list around by swapping every node's links
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+void list <T, A> :: reverse()
+{
+   for (Node * p = pHead; p; p = p->pPrev)
+      std::swap(p->pNext, p->pPrev);
+   std::swap(pHead, pTail);
+}
+
+/******************************************
+ * LIST :: EMPLACE
+ * build an item in a new node right where it is
+ * to go, from whatever its constructor takes
+ *     INPUT  : an iterator to the location where it is to be inserted
+ *              and the arguments for T's constructor
+ *     OUTPUT : iterator to the new item
+ *     COST   : O(1)
+ ******************************************/
+template <typename T, typename A>
+template <class ... Args>
+typename list <T, A> :: iterator list <T, A> :: emplace(iterator it, Args && ... args)
+{
+   Node * pNode = createNode(std::in_place, std::forward<Args>(args)...);
+   linkNodes(it.p, pNode, pNode);
+   numElements++;
+   return iterator(pNode);
+}
+
+/******************************************
+ * LIST :: SORT
+ * A stable, bottom-up merge sort. Each pass merges
+ * neighbouring runs of width nodes into runs of twice
+ * that, relinking the nodes as it goes, until one pass
+ * makes a single run. No value is copied or moved and
+ * nothing is allocated, so every iterator stays valid
+ * and still refers to the same value.
+ *     INPUT  : compare(a, b) is true when a goes before b
+ *     COST   : O(n log n) comparisons, O(1) extra space
+ ******************************************/
+template <typename T, typename A>
+template <class Compare>
+void list <T, A> :: sort(Compare compare)
+{
+   if (numElements < 2)
+      return;
+
+   for (size_t width = 1; ; width *= 2)
+   {
+      Node * pLeft = pHead;   // the first run of the next pair
+      Node * pLast = nullptr; // the last node of the merged list so far
+      size_t numMerges = 0;
+      pHead = nullptr;
+
+      while (pLeft)
+      {
+         numMerges++;
+
+         // the right run starts width nodes after the left one
+         Node * pRight = pLeft;
+         size_t sizeLeft = 0;
+         while (pRight && sizeLeft < width)
+         {
+            pRight = pRight->pNext;
+            sizeLeft++;
+         }
+         size_t sizeRight = width;
+
+         // take the smaller front node; the left one on a tie keeps it stable
+         while (sizeLeft > 0 || (sizeRight > 0 && pRight))
+         {
+            Node * pNode;
+            if (sizeLeft == 0 ||
+                (sizeRight > 0 && pRight && compare(pRight->data, pLeft->data)))
+            {
+               pNode = pRight;
+               pRight = pRight->pNext;
+               sizeRight--;
+            }
+            else
+            {
+               pNode = pLeft;
+               pLeft = pLeft->pNext;
+               sizeLeft--;
+            }
+
+            if (pLast)
+               pLast->pNext = pNode;
+            else
+               pHead = pNode;
+            pNode->pPrev = pLast;
+            pLast = pNode;
+         }
+
+         // both runs are used up, so the next pair starts where the right one ended
+         pLeft = pRight;
+      }
+
+      pLast->pNext = nullptr;
+      pTail = pLast;
+      if (numMerges <= 1)
+         return;
+   }
+}
+
 /**********************************************
  * LIST :: assignment operator - MOVE
  * Copy one list onto another
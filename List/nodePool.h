@@ -0,0 +1,374 @@
+/***********************************************************************
+ * Header:
+ *    NODE POOL
+ * Summary:
+ *    Fixed-size nodes carved out of large slabs and recycled through
+ *    a free list, so a busy list does not call malloc and free for
+ *    every push and erase
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        node_pool      : slabs of equal-sized blocks and a free list
+ *        pool_allocator : an allocator that hands out node_pool blocks
+ *        pooled_list    : a list whose nodes come from a node_pool
+ *
+ *    Every slab is a power of two in size and aligned to its size,
+ *    so the slab that owns a block is found by masking the block's
+ *    address. A freed block is pushed on the free list, with the
+ *    link stored in the block itself; nothing goes back to the
+ *    system until shrink() is called. A pool is not thread safe.
+ *
+ *       custom::pooled_list<Order> book;           // its own pool
+ *       custom::pool_allocator<Order> shared(4096);
+ *       custom::list<Order, custom::pool_allocator<Order>> a(shared), b(shared);
+ *       ...
+ *       a.get_allocator().shrink();                // give empty slabs back
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uintptr_t
+#include <memory>      // for std::shared_ptr and std::make_shared
+#include <new>         // for std::align_val_t
+#include <type_traits> // for std::true_type and std::false_type
+#include "list.h"
+
+class TestNodePool; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * NODE POOL
+ * Blocks of one size and alignment, handed out one
+ * at a time from slabs of many blocks
+ **************************************************/
+class node_pool
+{
+   friend class ::TestNodePool; // give unit tests access to the privates
+public:
+   // How many blocks a slab holds when no one says otherwise
+   static const size_t default_slab_blocks = 1024;
+
+   //
+   // Construct
+   //
+
+   // The block size is fixed by the first call to allocate()
+   explicit node_pool(size_t slabBlocks = default_slab_blocks) :
+      requestSize(0), blockSize(0), blockAlign(0), blockOffset(0),
+      slabBytes(0), blocksPerSlab(0),
+      slabBlocks(slabBlocks ? slabBlocks : 1),
+      pFree(nullptr), pSlabs(nullptr), pBump(nullptr), pBumpEnd(nullptr),
+      numSlabs(0), numInUse(0) { }
+   node_pool(const node_pool & rhs) = delete;
+   node_pool & operator = (const node_pool & rhs) = delete;
+   ~node_pool();
+
+   //
+   // Allocate
+   //
+
+   // Does this pool hand out blocks of this size and alignment?
+   bool serves(size_t size, size_t align)
+   {
+      if (blockSize == 0)
+         configure(size, align);
+      return size == requestSize && align <= blockAlign;
+   }
+
+   void * allocate();
+   void deallocate(void * p);
+
+   // Give every slab with no blocks in use back to the system
+   size_t shrink();
+
+   //
+   // Status
+   //
+
+   size_t slab_count()      const { return numSlabs;      }
+   size_t in_use()          const { return numInUse;      }
+   size_t blocks_per_slab() const { return blocksPerSlab; }
+
+private:
+   // the start of every slab; the blocks follow
+   struct Slab
+   {
+      Slab * pNext;      // the next slab the pool owns
+      size_t numInUse;   // blocks of this slab handed out and not returned
+   };
+
+   // a block on the free list holds only the link to the next one
+   struct FreeBlock
+   {
+      FreeBlock * pNext;
+   };
+
+   void configure(size_t size, size_t align);
+   void addSlab();
+
+   // the slab that block p was carved from
+   Slab * slabOf(const void * p) const
+   {
+      return reinterpret_cast<Slab *>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(slabBytes - 1));
+   }
+
+   // the first block of a slab
+   char * firstBlock(Slab * pSlab) const
+   {
+      return reinterpret_cast<char *>(pSlab) + blockOffset;
+   }
+
+   size_t requestSize;    // the size asked for on the first allocate()
+   size_t blockSize;      // the size of a block, room for a FreeBlock too
+   size_t blockAlign;     // the alignment of every block
+   size_t blockOffset;    // where the first block sits after the Slab header
+   size_t slabBytes;      // the size and alignment of a slab, a power of two
+   size_t blocksPerSlab;  // how many blocks fit in a slab
+   size_t slabBlocks;     // how many blocks a slab was asked to hold
+   FreeBlock * pFree;     // blocks given back, ready to hand out again
+   Slab * pSlabs;         // every slab the pool owns
+   char * pBump;          // the next never-used block in the newest slab
+   char * pBumpEnd;       // the end of the newest slab
+   size_t numSlabs;       // how many slabs the pool owns
+   size_t numInUse;       // how many blocks are handed out
+};
+
+/**********************************************
+ * NODE POOL :: DESTRUCTOR
+ * Every slab goes back, in use or not
+ *********************************************/
+inline node_pool :: ~node_pool()
+{
+   while (pSlabs)
+   {
+      Slab * pNext = pSlabs->pNext;
+      ::operator delete(pSlabs, std::align_val_t(slabBytes));
+      pSlabs = pNext;
+   }
+}
+
+/**********************************************
+ * NODE POOL :: CONFIGURE
+ * Fix the block size and alignment, then make the
+ * slab the smallest power of two that holds the
+ * header and slabBlocks blocks
+ *     INPUT  : the size and alignment of one node
+ *********************************************/
+inline void node_pool :: configure(size_t size, size_t align)
+{
+   requestSize = size;
+   blockAlign  = align < alignof(FreeBlock) ? alignof(FreeBlock) : align;
+   blockSize   = size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size;
+   blockSize   = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
+   blockOffset = (sizeof(Slab) + blockAlign - 1) / blockAlign * blockAlign;
+
+   slabBytes = 1;
+   while (slabBytes < blockOffset + slabBlocks * blockSize)
+      slabBytes *= 2;
+   blocksPerSlab = (slabBytes - blockOffset) / blockSize;
+}
+
+/**********************************************
+ * NODE POOL :: ADD SLAB
+ * Get one more slab from the system. Its blocks
+ * are carved off one at a time as they are needed,
+ * so a new slab is never written end to end.
+ *     COST   : O(1)
+ *********************************************/
+inline void node_pool :: addSlab()
+{
+   Slab * pSlab = static_cast<Slab *>(::operator new(slabBytes, std::align_val_t(slabBytes)));
+   pSlab->pNext = pSlabs;
+   pSlab->numInUse = 0;
+   pSlabs = pSlab;
+   numSlabs++;
+
+   pBump = firstBlock(pSlab);
+   pBumpEnd = pBump + blocksPerSlab * blockSize;
+}
+
+/**********************************************
+ * NODE POOL :: ALLOCATE
+ * Take a block from the free list if there is one,
+ * otherwise carve the next one from the newest slab
+ *     OUTPUT : room for one node
+ *     COST   : O(1)
+ *********************************************/
+inline void * node_pool :: allocate()
+{
+   void * p;
+   if (pFree)
+   {
+      p = pFree;
+      pFree = pFree->pNext;
+   }
+   else
+   {
+      if (pBump == pBumpEnd)
+         addSlab();
+      p = pBump;
+      pBump += blockSize;
+   }
+   slabOf(p)->numInUse++;
+   numInUse++;
+   return p;
+}
+
+/**********************************************
+ * NODE POOL :: DEALLOCATE
+ * Push the block on the free list. The slab stays
+ * even if this was its last block in use.
+ *     INPUT  : a block from allocate()
+ *     COST   : O(1)
+ *********************************************/
+inline void node_pool :: deallocate(void * p)
+{
+   FreeBlock * pBlock = static_cast<FreeBlock *>(p);
+   pBlock->pNext = pFree;
+   pFree = pBlock;
+   slabOf(p)->numInUse--;
+   numInUse--;
+}
+
+/**********************************************
+ * NODE POOL :: SHRINK
+ * Drop the free blocks of empty slabs from the
+ * free list, then give those slabs back
+ *     OUTPUT : how many slabs were given back
+ *     COST   : O(free blocks + slabs)
+ *********************************************/
+inline size_t node_pool :: shrink()
+{
+   // unlink every free block that lives in an empty slab
+   FreeBlock ** ppBlock = &pFree;
+   while (*ppBlock)
+   {
+      if (slabOf(*ppBlock)->numInUse == 0)
+         *ppBlock = (*ppBlock)->pNext;
+      else
+         ppBlock = &(*ppBlock)->pNext;
+   }
+
+   // then free the empty slabs themselves
+   size_t numFreed = 0;
+   Slab ** ppSlab = &pSlabs;
+   while (*ppSlab)
+   {
+      Slab * pSlab = *ppSlab;
+      if (pSlab->numInUse == 0)
+      {
+         if (pBumpEnd && slabOf(pBumpEnd - blockSize) == pSlab)
+            pBump = pBumpEnd = nullptr;
+         *ppSlab = pSlab->pNext;
+         ::operator delete(pSlab, std::align_val_t(slabBytes));
+         numSlabs--;
+         numFreed++;
+      }
+      else
+         ppSlab = &pSlab->pNext;
+   }
+   return numFreed;
+}
+
+/**************************************************
+ * POOL ALLOCATOR
+ * An allocator whose single objects come from a
+ * shared node_pool. Copies and rebinds share the
+ * pool; arrays and other sizes use operator new.
+ **************************************************/
+template <typename T>
+class pool_allocator
+{
+   friend class ::TestNodePool; // give unit tests access to the privates
+   template <typename U>
+   friend class pool_allocator;
+public:
+   typedef T value_type;
+
+   // nodes can only go back to the pool they came from, so the pool
+   // follows them when a list is moved or swapped
+   typedef std::false_type propagate_on_container_copy_assignment;
+   typedef std::true_type  propagate_on_container_move_assignment;
+   typedef std::true_type  propagate_on_container_swap;
+
+   //
+   // Construct
+   //
+
+   // A new pool whose slabs hold slabBlocks nodes
+   explicit pool_allocator(size_t slabBlocks = node_pool::default_slab_blocks) :
+      pPool(std::make_shared<node_pool>(slabBlocks)) { }
+
+   // Share the pool of another allocator
+   pool_allocator(const pool_allocator & rhs) : pPool(rhs.pPool) { }
+   template <typename U>
+   pool_allocator(const pool_allocator<U> & rhs) : pPool(rhs.pPool) { }
+
+   // A move shares the pool too: an allocator must still work, and
+   // compare equal, after it has been moved from
+   pool_allocator(pool_allocator && rhs) : pPool(rhs.pPool) { }
+   pool_allocator & operator = (const pool_allocator & rhs)
+   {
+      pPool = rhs.pPool;
+      return *this;
+   }
+   pool_allocator & operator = (pool_allocator && rhs)
+   {
+      pPool = rhs.pPool;
+      return *this;
+   }
+
+   //
+   // Allocate
+   //
+
+   T * allocate(size_t n)
+   {
+      if (n == 1 && pPool->serves(sizeof(T), alignof(T)))
+         return static_cast<T *>(pPool->allocate());
+      return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+   }
+
+   void deallocate(T * p, size_t n)
+   {
+      if (n == 1 && pPool->serves(sizeof(T), alignof(T)))
+         pPool->deallocate(p);
+      else
+         ::operator delete(p, std::align_val_t(alignof(T)));
+   }
+
+   // Give the pool's empty slabs back to the system
+   size_t shrink() { return pPool->shrink(); }
+
+   //
+   // Status
+   //
+
+   const node_pool & pool() const { return *pPool; }
+
+   template <typename U>
+   bool operator == (const pool_allocator<U> & rhs) const { return pPool == rhs.pPool; }
+   template <typename U>
+   bool operator != (const pool_allocator<U> & rhs) const { return pPool != rhs.pPool; }
+
+private:
+   std::shared_ptr<node_pool> pPool;   // shared by every copy and rebind
+};
+
+/**************************************************
+ * POOLED LIST
+ * A list with a node pool of its own
+ **************************************************/
+template <typename T>
+using pooled_list = list<T, pool_allocator<T>>;
+
+}; // namespace custom
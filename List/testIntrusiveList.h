@@ -0,0 +1,380 @@
+/***********************************************************************
+ * Header:
+ *    TEST INTRUSIVE LIST
+ * Summary:
+ *    Unit tests for intrusive_list and list_hook
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <initializer_list>      // for std::initializer_list
+#include "intrusiveList.h"       // class under test
+#include "../Array/unitTest.h"   // unit test baseclass
+#include "../Array/spy.h"        // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST INTRUSIVE LIST
+ * Unit tests for the intrusive list
+ ***********************************************/
+class TestIntrusiveList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_move();
+      test_destructor_unlinks();
+
+      // Insert
+      test_push();
+      test_insert_middle();
+      test_insert_linked();
+      test_twoHooks();
+
+      // Remove
+      test_erase();
+      test_erase_range();
+      test_unlink_fromObject();
+      test_hook_autoUnlink();
+      test_hook_copy();
+      test_removeIf();
+
+      // Relink
+      test_splice();
+      test_swap();
+      test_noCopies();
+
+      report("IntrusiveList");
+   }
+
+   // an object owned somewhere else, in up to two lists at once
+   struct Connection
+   {
+      Connection(int id = 0) : id(id) { }
+      int id;
+      custom::list_hook idle;
+      custom::list_hook all;
+   };
+   typedef custom::intrusive_list<Connection, &Connection::idle> IdleList;
+   typedef custom::intrusive_list<Connection, &Connection::all>  AllList;
+
+   // an object that counts its copies and moves
+   struct Watched
+   {
+      Watched(int id) : spy(id) { }
+      Spy spy;
+      custom::list_hook hook;
+   };
+   typedef custom::intrusive_list<Watched, &Watched::hook> WatchedList;
+
+   // the ids front to back are expect, and every link agrees
+   template <class L>
+   static bool holds(L & l, std::initializer_list<int> expect)
+   {
+      auto itExpect = expect.begin();
+      for (auto it = l.begin(); it != l.end(); ++it, ++itExpect)
+      {
+         if (itExpect == expect.end() || (*it).id != *itExpect)
+            return false;
+         if (it.p->pNext->pPrev != it.p || !it.p->is_linked())
+            return false;
+      }
+      return itExpect == expect.end() && l.size() == expect.size() &&
+             l.root.pNext->pPrev == &l.root && l.root.pPrev->pNext == &l.root;
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty list is its root linked to itself
+   void test_construct_default()
+   {  // setup
+      // exercise
+      IdleList l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.root.pNext == &l.root);
+      assertUnit(l.root.pPrev == &l.root);
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // a move takes the objects and leaves the source empty
+   void test_construct_move()
+   {  // setup
+      Connection c[3] = { 1, 2, 3 };
+      IdleList a;
+      for (int i = 0; i < 3; i++)
+         a.push_back(c[i]);
+      // exercise
+      IdleList b(std::move(a));
+      // verify
+      assertUnit(holds(b, { 1, 2, 3 }));
+      assertUnit(holds(a, { }));
+      IdleList d;
+      d = std::move(b);
+      assertUnit(holds(d, { 1, 2, 3 }));
+      assertUnit(b.empty());
+   }  // teardown
+
+   // a list going away leaves its objects alone and unlinked
+   void test_destructor_unlinks()
+   {  // setup
+      Connection c[2] = { 1, 2 };
+      // exercise
+      {
+         IdleList l;
+         l.push_back(c[0]);
+         l.push_back(c[1]);
+      }
+      // verify
+      assertUnit(!c[0].idle.is_linked());
+      assertUnit(!c[1].idle.is_linked());
+      assertUnit(c[1].id == 2);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push at both ends
+   void test_push()
+   {  // setup
+      Connection c[3] = { 1, 2, 3 };
+      IdleList l;
+      // exercise
+      l.push_back(c[1]);
+      l.push_front(c[0]);
+      l.push_back(c[2]);
+      // verify
+      assertUnit(holds(l, { 1, 2, 3 }));
+      assertUnit(&l.front() == &c[0]);
+      assertUnit(&l.back() == &c[2]);
+   }  // teardown
+
+   // insert goes before the iterator and returns the new object
+   void test_insert_middle()
+   {  // setup
+      Connection c[3] = { 1, 2, 3 };
+      IdleList l;
+      l.push_back(c[0]);
+      l.push_back(c[2]);
+      // exercise
+      auto it = l.insert(IdleList::iterator_to(c[2]), c[1]);
+      // verify
+      assertUnit(&*it == &c[1]);
+      assertUnit(holds(l, { 1, 2, 3 }));
+   }  // teardown
+
+   // an object can be in only one list per hook
+   void test_insert_linked()
+   {  // setup
+      Connection c(1);
+      IdleList a;
+      IdleList b;
+      a.push_back(c);
+      bool threw = false;
+      // exercise
+      try
+      {
+         b.push_back(c);
+      }
+      catch (const char *)
+      {
+         threw = true;
+      }
+      // verify
+      assertUnit(threw);
+      assertUnit(holds(a, { 1 }));
+      assertUnit(holds(b, { }));
+   }  // teardown
+
+   // an object with two hooks can be in two lists
+   void test_twoHooks()
+   {  // setup
+      Connection c[3] = { 1, 2, 3 };
+      IdleList idle;
+      AllList all;
+      // exercise
+      for (int i = 0; i < 3; i++)
+         all.push_back(c[i]);
+      idle.push_back(c[2]);
+      idle.push_back(c[0]);
+      // verify
+      assertUnit(holds(all, { 1, 2, 3 }));
+      assertUnit(holds(idle, { 3, 1 }));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase returns the object after and leaves the object alone
+   void test_erase()
+   {  // setup
+      Connection c[3] = { 1, 2, 3 };
+      IdleList l;
+      for (int i = 0; i < 3; i++)
+         l.push_back(c[i]);
+      // exercise
+      auto it = l.erase(IdleList::iterator_to(c[1]));
+      // verify
+      assertUnit(&*it == &c[2]);
+      assertUnit(holds(l, { 1, 3 }));
+      assertUnit(!c[1].idle.is_linked());
+      l.pop_front();
+      l.pop_back();
+      l.pop_back();
+      assertUnit(holds(l, { }));
+   }  // teardown
+
+   // a range is unlinked and the end of it returned
+   void test_erase_range()
+   {  // setup
+      Connection c[4] = { 1, 2, 3, 4 };
+      IdleList l;
+      for (int i = 0; i < 4; i++)
+         l.push_back(c[i]);
+      // exercise
+      auto it = l.erase(IdleList::iterator_to(c[1]), IdleList::iterator_to(c[3]));
+      // verify
+      assertUnit(&*it == &c[3]);
+      assertUnit(holds(l, { 1, 4 }));
+   }  // teardown
+
+   // an object leaves its list with no list in hand
+   void test_unlink_fromObject()
+   {  // setup
+      Connection c[3] = { 1, 2, 3 };
+      IdleList l;
+      for (int i = 0; i < 3; i++)
+         l.push_back(c[i]);
+      // exercise
+      IdleList::unlink(c[0]);
+      c[2].idle.unlink();
+      c[2].idle.unlink();
+      // verify
+      assertUnit(holds(l, { 2 }));
+      assertUnit(!c[0].idle.is_linked());
+   }  // teardown
+
+   // an object destroyed while in a list takes itself out
+   void test_hook_autoUnlink()
+   {  // setup
+      Connection first(1);
+      Connection last(3);
+      IdleList l;
+      l.push_back(first);
+      // exercise
+      {
+         Connection middle(2);
+         l.push_back(middle);
+         l.push_back(last);
+      }
+      // verify
+      assertUnit(holds(l, { 1, 3 }));
+   }  // teardown
+
+   // a copy of an object is in no list, and assigning keeps the links
+   void test_hook_copy()
+   {  // setup
+      Connection c(1);
+      Connection d(2);
+      IdleList l;
+      l.push_back(c);
+      // exercise
+      Connection copy(c);
+      d = c;
+      // verify
+      assertUnit(!copy.idle.is_linked());
+      assertUnit(!d.idle.is_linked());
+      assertUnit(copy.id == 1);
+      assertUnit(holds(l, { 1 }));
+   }  // teardown
+
+   // every object the predicate picks is unlinked
+   void test_removeIf()
+   {  // setup
+      Connection c[5] = { 1, 2, 3, 4, 5 };
+      IdleList l;
+      for (int i = 0; i < 5; i++)
+         l.push_back(c[i]);
+      // exercise
+      size_t num = l.remove_if([](const Connection & conn) { return conn.id % 2; });
+      // verify
+      assertUnit(num == 3);
+      assertUnit(holds(l, { 2, 4 }));
+   }  // teardown
+
+   /***************************************
+    * RELINK
+    ***************************************/
+
+   // whole lists and single objects move between lists
+   void test_splice()
+   {  // setup
+      Connection c[5] = { 1, 2, 3, 4, 5 };
+      IdleList a;
+      IdleList b;
+      a.push_back(c[0]);
+      a.push_back(c[4]);
+      b.push_back(c[1]);
+      b.push_back(c[2]);
+      b.push_back(c[3]);
+      // exercise
+      a.splice(IdleList::iterator_to(c[4]), b);
+      // verify
+      assertUnit(holds(a, { 1, 2, 3, 4, 5 }));
+      assertUnit(holds(b, { }));
+      b.splice(b.end(), a, IdleList::iterator_to(c[2]));
+      assertUnit(holds(a, { 1, 2, 4, 5 }));
+      assertUnit(holds(b, { 3 }));
+      a.splice(a.begin(), a, a.rbegin());
+      assertUnit(holds(a, { 5, 1, 2, 4 }));
+   }  // teardown
+
+   // swap exchanges the objects
+   void test_swap()
+   {  // setup
+      Connection c[3] = { 1, 2, 3 };
+      IdleList a;
+      IdleList b;
+      a.push_back(c[0]);
+      b.push_back(c[1]);
+      b.push_back(c[2]);
+      // exercise
+      swap(a, b);
+      // verify
+      assertUnit(holds(a, { 2, 3 }));
+      assertUnit(holds(b, { 1 }));
+   }  // teardown
+
+   // linking never copies or moves the object
+   void test_noCopies()
+   {  // setup
+      Watched w[3] = { 1, 2, 3 };
+      WatchedList l;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 3; i++)
+         l.push_back(w[i]);
+      l.erase(l.begin());
+      l.push_front(w[0]);
+      l.clear();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,38 @@
+/***********************************************************************
+ * Header:
+ *    Test
+ * Summary:
+ *    Driver to test list.h
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#ifndef DEBUG
+#define DEBUG
+#endif
+ //#undef DEBUG  // Remove this comment to disable unit tests
+
+#include "testList.h"       // for the list unit tests
+#include "testNodePool.h"   // for the node pool unit tests
+#include "testUnrolledList.h" // for the unrolled list unit tests
+#include "testIntrusiveList.h" // for the intrusive list unit tests
+int Spy::counters[] = {};
+
+
+/**********************************************************************
+ * MAIN
+ * This is just a simple menu to launch a collection of tests
+ ***********************************************************************/
+int main()
+{
+
+#ifdef DEBUG
+   // unit tests
+   TestList().run();
+   TestNodePool().run();
+   TestUnrolledList().run();
+   TestIntrusiveList().run();
+#endif // DEBUG
+
+   return 0;
+}
@@ -0,0 +1,1039 @@
+/***********************************************************************
+ * Header:
+ *    TEST LIST
+ * Summary:
+ *    Unit tests for list
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <initializer_list>      // for std::initializer_list
+#include <new>                   // for operator new and placement new
+#include <stdexcept>             // for std::runtime_error
+#include <type_traits>           // for std::integral_constant
+#include <utility>               // for std::forward
+#include "list.h"                // class under test
+#include "../Array/unitTest.h"   // unit test baseclass
+#include "../Array/spy.h"        // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * ALLOC COUNTS
+ * What one family of CountingAllocators has done
+ ***********************************************/
+struct AllocCounts
+{
+   int numAllocate;    // objects allocated
+   int numDeallocate;  // objects deallocated
+   int numConstruct;   // objects constructed through the allocator
+   int numDestroy;     // objects destroyed through the allocator
+
+   int live() const { return numAllocate - numDeallocate; }
+};
+
+/***********************************************
+ * COUNTING ALLOCATOR
+ * An allocator that reports everything it does to
+ * an AllocCounts. Two are equal when they report
+ * to the same one. Propagate sets whether it follows
+ * its containers on copy, move and swap.
+ ***********************************************/
+template <typename T, bool Propagate = false>
+struct CountingAllocator
+{
+   typedef T value_type;
+   typedef std::integral_constant<bool, Propagate> propagate_on_container_copy_assignment;
+   typedef std::integral_constant<bool, Propagate> propagate_on_container_move_assignment;
+   typedef std::integral_constant<bool, Propagate> propagate_on_container_swap;
+
+   template <typename U>
+   struct rebind
+   {
+      typedef CountingAllocator<U, Propagate> other;
+   };
+
+   explicit CountingAllocator(AllocCounts * pCounts) : pCounts(pCounts) { }
+   template <typename U>
+   CountingAllocator(const CountingAllocator<U, Propagate> & rhs) : pCounts(rhs.pCounts) { }
+
+   T * allocate(size_t n)
+   {
+      pCounts->numAllocate += (int)n;
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+   }
+   void deallocate(T * p, size_t n)
+   {
+      pCounts->numDeallocate += (int)n;
+      ::operator delete(p);
+   }
+
+   template <typename U, typename ... Args>
+   void construct(U * p, Args && ... args)
+   {
+      pCounts->numConstruct++;
+      ::new ((void *)p) U(std::forward<Args>(args)...);
+   }
+   template <typename U>
+   void destroy(U * p)
+   {
+      pCounts->numDestroy++;
+      p->~U();
+   }
+
+   AllocCounts * pCounts;
+};
+
+template <typename T, typename U, bool Propagate>
+bool operator == (const CountingAllocator<T, Propagate> & lhs,
+                  const CountingAllocator<U, Propagate> & rhs)
+{
+   return lhs.pCounts == rhs.pCounts;
+}
+
+template <typename T, typename U, bool Propagate>
+bool operator != (const CountingAllocator<T, Propagate> & lhs,
+                  const CountingAllocator<U, Propagate> & rhs)
+{
+   return !(lhs == rhs);
+}
+
+/***********************************************
+ * TEST LIST
+ * Unit tests for the list class
+ ***********************************************/
+class TestList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Allocator
+      test_alloc_construct();
+      test_alloc_getAllocator();
+      test_alloc_pushBack();
+      test_alloc_pushFront();
+      test_alloc_insert();
+      test_alloc_pop();
+      test_alloc_erase();
+      test_alloc_destructor();
+      test_alloc_throws();
+      test_alloc_spy();
+
+      // Propagation
+      test_copy_selectsAllocator();
+      test_copy_withAllocator();
+      test_move_stealsAllocator();
+      test_move_unequalAllocator();
+      test_assignCopy_propagate();
+      test_assignCopy_noPropagate();
+      test_assignMove_propagate();
+      test_assignMove_unequal();
+      test_swap_propagate();
+
+      // Sort
+      test_sort_empty();
+      test_sort_ints();
+      test_sort_compare();
+      test_sort_stable();
+      test_sort_links();
+      test_sort_iteratorsKept();
+      test_sort_spy();
+
+      // Relink
+      test_splice_all();
+      test_splice_one();
+      test_splice_oneSameList();
+      test_splice_range();
+      test_splice_rangeSameList();
+      test_merge();
+      test_merge_stable();
+      test_reverse();
+      test_remove();
+      test_remove_aliased();
+      test_removeIf();
+      test_unique();
+      test_erase_range();
+      test_relink_spy();
+
+      // Emplace
+      test_emplaceBack_spy();
+      test_emplaceFront_spy();
+      test_emplace_middle();
+      test_emplace_args();
+      test_emplace_throws();
+      test_construct_countDefault();
+      test_construct_countValue();
+
+      report("List");
+   }
+
+   typedef CountingAllocator<int>       Alloc;
+   typedef CountingAllocator<int, true> PropagatingAlloc;
+
+   // a value whose copies can be made to fail
+   struct Thrower
+   {
+      Thrower(bool fail) : fail(fail) { }
+      Thrower(const Thrower & rhs) : fail(rhs.fail)
+      {
+         if (fail)
+            throw std::runtime_error("copy failed");
+      }
+      bool fail;
+   };
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // an empty list asks for nothing
+   void test_alloc_construct()
+   {  // setup
+      AllocCounts counts = {};
+      // exercise
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      // verify
+      assertUnit(l.empty());
+      assertUnit(counts.numAllocate == 0);
+   }  // teardown
+
+   // the allocator we gave is the allocator we get back
+   void test_alloc_getAllocator()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      // exercise
+      Alloc a = l.get_allocator();
+      // verify
+      assertUnit(a.pCounts == &counts);
+   }  // teardown
+
+   // one node from the allocator for every element, copied or moved
+   void test_alloc_pushBack()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      int value = 10;
+      // exercise
+      l.push_back(value);
+      l.push_back(20);
+      // verify
+      assertUnit(counts.numAllocate == 2);
+      assertUnit(counts.numConstruct == 2);
+      assertUnit(l.front() == 10);
+      assertUnit(l.back() == 20);
+   }  // teardown
+
+   // the same at the front
+   void test_alloc_pushFront()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      int value = 10;
+      // exercise
+      l.push_front(value);
+      l.push_front(20);
+      // verify
+      assertUnit(counts.numAllocate == 2);
+      assertUnit(counts.numConstruct == 2);
+      assertUnit(l.front() == 20);
+   }  // teardown
+
+   // the same in the middle
+   void test_alloc_insert()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      l.push_back(10);
+      l.push_back(30);
+      int value = 20;
+      // exercise
+      l.insert(++l.begin(), value);
+      l.insert(l.end(), 40);
+      // verify
+      assertUnit(counts.numAllocate == 4);
+      assertUnit(counts.numConstruct == 4);
+      assertUnit(l.size() == 4);
+   }  // teardown
+
+   // each pop gives one node back
+   void test_alloc_pop()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      l.push_back(10);
+      l.push_back(20);
+      l.push_back(30);
+      // exercise
+      l.pop_back();
+      l.pop_front();
+      // verify
+      assertUnit(counts.numDeallocate == 2);
+      assertUnit(counts.numDestroy == 2);
+      assertUnit(counts.live() == 1);
+      assertUnit(l.front() == 20);
+   }  // teardown
+
+   // erase and clear give the nodes back
+   void test_alloc_erase()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      l.push_back(10);
+      l.push_back(20);
+      l.push_back(30);
+      // exercise
+      l.erase(++l.begin());
+      int afterErase = counts.numDeallocate;
+      l.clear();
+      // verify
+      assertUnit(afterErase == 1);
+      assertUnit(counts.numDeallocate == 3);
+      assertUnit(counts.numDestroy == 3);
+   }  // teardown
+
+   // nothing is left when the list goes away
+   void test_alloc_destructor()
+   {  // setup
+      AllocCounts counts = {};
+      // exercise
+      {
+         custom::list<int, Alloc> l{Alloc(&counts)};
+         for (int i = 0; i < 10; i++)
+            l.push_back(i);
+      }
+      // verify
+      assertUnit(counts.numAllocate == 10);
+      assertUnit(counts.live() == 0);
+      assertUnit(counts.numDestroy == 10);
+   }  // teardown
+
+   // a node whose value fails to construct goes straight back
+   void test_alloc_throws()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<Thrower, CountingAllocator<Thrower> > l{CountingAllocator<Thrower>(&counts)};
+      l.push_back(Thrower(false));
+      Thrower bad(true);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         l.push_back(bad);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(l.size() == 1);
+      assertUnit(counts.numAllocate == 2);
+      assertUnit(counts.live() == 1);
+   }  // teardown
+
+   // the values are copied or moved exactly as without an allocator
+   void test_alloc_spy()
+   {  // setup
+      AllocCounts counts = {};
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      {
+         custom::list<Spy, CountingAllocator<Spy> > l{CountingAllocator<Spy>(&counts)};
+         l.push_back(s);
+         l.push_back(Spy(1));
+      }
+      // verify
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(counts.numConstruct == 2);
+      assertUnit(counts.live() == 0);
+   }  // teardown
+
+   /***************************************
+    * PROPAGATION
+    ***************************************/
+
+   // a copy asks the source's allocator which allocator to use
+   void test_copy_selectsAllocator()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      l.push_back(1);
+      l.push_back(2);
+      // exercise
+      custom::list<int, Alloc> copy(l);
+      // verify
+      assertUnit(copy.get_allocator() == l.get_allocator());
+      assertUnit(counts.numAllocate == 4);
+      assertUnit(copy.size() == 2);
+      assertUnit(copy.back() == 2);
+   }  // teardown
+
+   // a copy into nodes from a different allocator
+   void test_copy_withAllocator()
+   {  // setup
+      AllocCounts countsSource = {};
+      AllocCounts countsCopy = {};
+      custom::list<int, Alloc> l{Alloc(&countsSource)};
+      l.push_back(1);
+      l.push_back(2);
+      // exercise
+      custom::list<int, Alloc> copy(l, Alloc(&countsCopy));
+      // verify
+      assertUnit(countsSource.numAllocate == 2);
+      assertUnit(countsCopy.numAllocate == 2);
+      assertUnit(copy.front() == 1);
+   }  // teardown
+
+   // a move takes the nodes and the allocator that must free them
+   void test_move_stealsAllocator()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<int, Alloc> l{Alloc(&counts)};
+      l.push_back(1);
+      l.push_back(2);
+      // exercise
+      custom::list<int, Alloc> moved(std::move(l));
+      // verify
+      assertUnit(counts.numAllocate == 2);
+      assertUnit(moved.get_allocator().pCounts == &counts);
+      assertUnit(moved.size() == 2);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // a move into a different allocator moves the values, not the nodes
+   void test_move_unequalAllocator()
+   {  // setup
+      AllocCounts countsSource = {};
+      AllocCounts countsDest = {};
+      custom::list<int, Alloc> l{Alloc(&countsSource)};
+      l.push_back(1);
+      l.push_back(2);
+      // exercise
+      custom::list<int, Alloc> moved(std::move(l), Alloc(&countsDest));
+      // verify
+      assertUnit(countsDest.numAllocate == 2);
+      assertUnit(countsSource.live() == 0);
+      assertUnit(moved.back() == 2);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // a propagating allocator frees our old nodes, then makes the new ones
+   void test_assignCopy_propagate()
+   {  // setup
+      AllocCounts countsLHS = {};
+      AllocCounts countsRHS = {};
+      custom::list<int, PropagatingAlloc> lhs{PropagatingAlloc(&countsLHS)};
+      custom::list<int, PropagatingAlloc> rhs{PropagatingAlloc(&countsRHS)};
+      lhs.push_back(1);
+      rhs.push_back(2);
+      rhs.push_back(3);
+      // exercise
+      lhs = rhs;
+      // verify
+      assertUnit(countsLHS.live() == 0);
+      assertUnit(countsRHS.live() == 4);
+      assertUnit(lhs.get_allocator() == rhs.get_allocator());
+      assertUnit(lhs.front() == 2);
+   }  // teardown
+
+   // an allocator that does not propagate keeps our nodes where they are
+   void test_assignCopy_noPropagate()
+   {  // setup
+      AllocCounts countsLHS = {};
+      AllocCounts countsRHS = {};
+      custom::list<int, Alloc> lhs{Alloc(&countsLHS)};
+      custom::list<int, Alloc> rhs{Alloc(&countsRHS)};
+      lhs.push_back(1);
+      rhs.push_back(2);
+      rhs.push_back(3);
+      // exercise
+      lhs = rhs;
+      // verify
+      assertUnit(countsLHS.live() == 2);
+      assertUnit(countsRHS.live() == 2);
+      assertUnit(lhs.get_allocator().pCounts == &countsLHS);
+      assertUnit(lhs.back() == 3);
+   }  // teardown
+
+   // a propagating allocator comes along with the nodes
+   void test_assignMove_propagate()
+   {  // setup
+      AllocCounts countsLHS = {};
+      AllocCounts countsRHS = {};
+      custom::list<int, PropagatingAlloc> lhs{PropagatingAlloc(&countsLHS)};
+      custom::list<int, PropagatingAlloc> rhs{PropagatingAlloc(&countsRHS)};
+      lhs.push_back(1);
+      rhs.push_back(2);
+      // exercise
+      lhs = std::move(rhs);
+      // verify
+      assertUnit(countsLHS.live() == 0);
+      assertUnit(countsRHS.numAllocate == 1);
+      assertUnit(lhs.get_allocator().pCounts == &countsRHS);
+      assertUnit(lhs.front() == 2);
+      assertUnit(rhs.empty());
+   }  // teardown
+
+   // with unequal allocators that stay put, the values move one at a time
+   void test_assignMove_unequal()
+   {  // setup
+      AllocCounts countsLHS = {};
+      AllocCounts countsRHS = {};
+      custom::list<int, Alloc> lhs{Alloc(&countsLHS)};
+      custom::list<int, Alloc> rhs{Alloc(&countsRHS)};
+      rhs.push_back(2);
+      rhs.push_back(3);
+      // exercise
+      lhs = std::move(rhs);
+      // verify
+      assertUnit(countsLHS.live() == 2);
+      assertUnit(countsRHS.live() == 0);
+      assertUnit(lhs.get_allocator().pCounts == &countsLHS);
+      assertUnit(lhs.back() == 3);
+   }  // teardown
+
+   // the allocators swap along with the nodes they made
+   void test_swap_propagate()
+   {  // setup
+      AllocCounts countsLHS = {};
+      AllocCounts countsRHS = {};
+      // exercise
+      {
+         custom::list<int, PropagatingAlloc> lhs{PropagatingAlloc(&countsLHS)};
+         custom::list<int, PropagatingAlloc> rhs{PropagatingAlloc(&countsRHS)};
+         lhs.push_back(1);
+         rhs.push_back(2);
+         rhs.push_back(3);
+         lhs.swap(rhs);
+         assertUnit(lhs.get_allocator().pCounts == &countsRHS);
+         assertUnit(rhs.get_allocator().pCounts == &countsLHS);
+         assertUnit(lhs.size() == 2);
+      }
+      // verify
+      assertUnit(countsLHS.live() == 0);
+      assertUnit(countsRHS.live() == 0);
+      assertUnit(countsLHS.numDestroy == 1);
+      assertUnit(countsRHS.numDestroy == 2);
+   }  // teardown
+
+   /***************************************
+    * SORT
+    ***************************************/
+
+   // a key to sort by and a tag to tell equal keys apart
+   struct Keyed
+   {
+      int key;
+      int tag;
+      bool operator < (const Keyed & rhs) const { return key < rhs.key; }
+   };
+
+   // nothing to do for zero or one element
+   void test_sort_empty()
+   {  // setup
+      custom::list<int> none;
+      custom::list<int> one{ 5 };
+      // exercise
+      none.sort();
+      one.sort();
+      // verify
+      assertUnit(none.empty());
+      assertUnit(none.pHead == nullptr);
+      assertUnit(one.size() == 1);
+      assertUnit(one.front() == 5);
+      assertUnit(one.pHead == one.pTail);
+   }  // teardown
+
+   // values end up in ascending order
+   void test_sort_ints()
+   {  // setup
+      custom::list<int> l{ 5, 3, 9, 1, 7, 2, 8, 6, 4, 0, 3 };
+      int expect[] = { 0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9 };
+      // exercise
+      l.sort();
+      // verify
+      bool inOrder = true;
+      int i = 0;
+      for (auto it = l.begin(); it != l.end(); ++it, ++i)
+         inOrder = inOrder && *it == expect[i];
+      assertUnit(inOrder);
+      assertUnit(i == 11);
+      assertUnit(l.size() == 11);
+   }  // teardown
+
+   // a comparison can put the values in any order
+   void test_sort_compare()
+   {  // setup
+      custom::list<int> l{ 1, 4, 2, 5, 3 };
+      // exercise
+      l.sort([](int a, int b) { return a > b; });
+      // verify
+      assertUnit(l.front() == 5);
+      assertUnit(l.back() == 1);
+      bool descending = true;
+      int last = 6;
+      for (auto it = l.begin(); it != l.end(); ++it)
+      {
+         descending = descending && *it < last;
+         last = *it;
+      }
+      assertUnit(descending);
+   }  // teardown
+
+   // equal keys keep the order they came in
+   void test_sort_stable()
+   {  // setup
+      custom::list<Keyed> l;
+      for (int i = 0; i < 100; i++)
+         l.push_back(Keyed{ (i * 37) % 7, i });
+      // exercise
+      l.sort();
+      // verify
+      bool stable = true;
+      Keyed last = { -1, -1 };
+      for (auto it = l.begin(); it != l.end(); ++it)
+      {
+         stable = stable && (last.key < (*it).key ||
+                             (last.key == (*it).key && last.tag < (*it).tag));
+         last = *it;
+      }
+      assertUnit(stable);
+      assertUnit(l.size() == 100);
+   }  // teardown
+
+   // every back link, the head and the tail agree with the new order
+   void test_sort_links()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 0; i < 37; i++)
+         l.push_back((i * 11) % 37);
+      // exercise
+      l.sort();
+      // verify
+      bool linked = l.pHead->pPrev == nullptr && l.pTail->pNext == nullptr;
+      size_t count = 0;
+      for (auto p = l.pHead; p; p = p->pNext, count++)
+         linked = linked && (p->pNext ? p->pNext->pPrev == p : l.pTail == p);
+      assertUnit(linked);
+      assertUnit(count == 37);
+      assertUnit(l.front() == 0);
+      assertUnit(l.back() == 36);
+   }  // teardown
+
+   // an iterator still refers to the same value after the sort
+   void test_sort_iteratorsKept()
+   {  // setup
+      custom::list<int> l{ 30, 10, 20 };
+      auto it30 = l.begin();
+      auto pNodes = l.pHead;
+      // exercise
+      l.sort();
+      // verify
+      assertUnit(*it30 == 30);
+      assertUnit(it30 == l.rbegin());
+      assertUnit(l.pTail == pNodes);
+   }  // teardown
+
+   // nodes are relinked, never copied, moved or allocated
+   void test_sort_spy()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<Spy, CountingAllocator<Spy> > l{CountingAllocator<Spy>(&counts)};
+      for (int i = 0; i < 64; i++)
+         l.push_back(Spy((i * 29) % 64));
+      Spy::reset();
+      int allocated = counts.numAllocate;
+      // exercise
+      l.sort();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(counts.numAllocate == allocated);
+      assertUnit(Spy::numLessthan() <= 64 * 6);
+      assertUnit(l.front() == Spy(0));
+   }  // teardown
+
+   /***************************************
+    * RELINK
+    ***************************************/
+
+   // the values front to back are expect, and every link agrees
+   template <class L>
+   static bool holds(L & l, std::initializer_list<int> expect)
+   {
+      if (l.size() != expect.size())
+         return false;
+      if (l.pHead && (l.pHead->pPrev || l.pTail->pNext))
+         return false;
+      auto itExpect = expect.begin();
+      size_t count = 0;
+      for (auto p = l.pHead; p; p = p->pNext, ++itExpect, count++)
+      {
+         if (itExpect == expect.end() || !(p->data == *itExpect))
+            return false;
+         if (p->pNext ? p->pNext->pPrev != p : l.pTail != p)
+            return false;
+      }
+      return count == expect.size() && (count || l.pTail == nullptr);
+   }
+
+   // an iterator to the item at index
+   template <class L>
+   static typename L::iterator at(L & l, int index)
+   {
+      auto it = l.begin();
+      for (int i = 0; i < index; i++)
+         ++it;
+      return it;
+   }
+
+   // a whole list moves in, leaving the other empty
+   void test_splice_all()
+   {  // setup
+      custom::list<int> l{ 1, 5 };
+      custom::list<int> rhs{ 2, 3, 4 };
+      auto it3 = at(rhs, 1);
+      // exercise
+      l.splice(at(l, 1), rhs);
+      // verify
+      assertUnit(holds(l, { 1, 2, 3, 4, 5 }));
+      assertUnit(holds(rhs, { }));
+      assertUnit(*it3 == 3);
+      l.splice(l.end(), rhs);
+      assertUnit(l.size() == 5);
+   }  // teardown
+
+   // one item moves from another list, to the front or the end
+   void test_splice_one()
+   {  // setup
+      custom::list<int> l{ 2, 3 };
+      custom::list<int> rhs{ 1, 9, 4 };
+      // exercise
+      l.splice(l.begin(), rhs, rhs.begin());
+      l.splice(l.end(), rhs, at(rhs, 1));
+      // verify
+      assertUnit(holds(l, { 1, 2, 3, 4 }));
+      assertUnit(holds(rhs, { 9 }));
+   }  // teardown
+
+   // one item moves within its own list
+   void test_splice_oneSameList()
+   {  // setup
+      custom::list<int> l{ 4, 1, 2, 3 };
+      // exercise
+      l.splice(l.end(), l, l.begin());
+      l.splice(l.begin(), l, l.begin());
+      l.splice(at(l, 1), l, l.begin());
+      // verify
+      assertUnit(holds(l, { 1, 2, 3, 4 }));
+   }  // teardown
+
+   // a run of items moves from another list
+   void test_splice_range()
+   {  // setup
+      custom::list<int> l{ 1, 5 };
+      custom::list<int> rhs{ 0, 2, 3, 4, 6 };
+      // exercise
+      l.splice(at(l, 1), rhs, at(rhs, 1), at(rhs, 4));
+      // verify
+      assertUnit(holds(l, { 1, 2, 3, 4, 5 }));
+      assertUnit(holds(rhs, { 0, 6 }));
+      l.splice(l.end(), rhs, rhs.begin(), rhs.end());
+      assertUnit(holds(l, { 1, 2, 3, 4, 5, 0, 6 }));
+      assertUnit(holds(rhs, { }));
+   }  // teardown
+
+   // a run of items moves within its own list
+   void test_splice_rangeSameList()
+   {  // setup
+      custom::list<int> l{ 3, 4, 5, 1, 2 };
+      // exercise
+      l.splice(l.end(), l, l.begin(), at(l, 3));
+      // verify
+      assertUnit(holds(l, { 1, 2, 3, 4, 5 }));
+      l.splice(at(l, 3), l, at(l, 3), l.end());
+      assertUnit(holds(l, { 1, 2, 3, 4, 5 }));
+   }  // teardown
+
+   // two sorted lists become one sorted list
+   void test_merge()
+   {  // setup
+      custom::list<int> l{ 1, 4, 6, 9 };
+      custom::list<int> rhs{ 0, 2, 3, 7, 8, 10, 11 };
+      // exercise
+      l.merge(rhs);
+      // verify
+      assertUnit(holds(l, { 0, 1, 2, 3, 4, 6, 7, 8, 9, 10, 11 }));
+      assertUnit(holds(rhs, { }));
+   }  // teardown
+
+   // on a tie ours stay ahead of theirs
+   void test_merge_stable()
+   {  // setup
+      custom::list<Keyed> l;
+      custom::list<Keyed> rhs;
+      for (int i = 0; i < 6; i++)
+      {
+         l.push_back(Keyed{ i / 2, 0 });
+         rhs.push_back(Keyed{ i / 3, 1 });
+      }
+      // exercise
+      l.merge(rhs);
+      // verify
+      bool stable = true;
+      Keyed last = { -1, 0 };
+      for (auto it = l.begin(); it != l.end(); ++it)
+      {
+         stable = stable && (last.key < (*it).key ||
+                             (last.key == (*it).key && last.tag <= (*it).tag));
+         last = *it;
+      }
+      assertUnit(stable);
+      assertUnit(l.size() == 12);
+      assertUnit(rhs.empty());
+   }  // teardown
+
+   // the list runs the other way
+   void test_reverse()
+   {  // setup
+      custom::list<int> none;
+      custom::list<int> l{ 1, 2, 3, 4 };
+      auto it2 = at(l, 1);
+      // exercise
+      none.reverse();
+      l.reverse();
+      // verify
+      assertUnit(holds(none, { }));
+      assertUnit(holds(l, { 4, 3, 2, 1 }));
+      ++it2;
+      assertUnit(*it2 == 1);
+   }  // teardown
+
+   // every item equal to the value goes
+   void test_remove()
+   {  // setup
+      custom::list<int> l{ 7, 1, 7, 2, 7 };
+      // exercise
+      size_t num = l.remove(7);
+      // verify
+      assertUnit(num == 3);
+      assertUnit(holds(l, { 1, 2 }));
+   }  // teardown
+
+   // the value can be one of the items removed
+   void test_remove_aliased()
+   {  // setup
+      custom::list<Spy> l;
+      l.push_back(Spy(3));
+      l.push_back(Spy(1));
+      l.push_back(Spy(3));
+      // exercise
+      size_t num = l.remove(l.front());
+      // verify
+      assertUnit(num == 2);
+      assertUnit(l.size() == 1);
+      assertUnit(l.front() == Spy(1));
+   }  // teardown
+
+   // every item the predicate picks goes
+   void test_removeIf()
+   {  // setup
+      custom::list<int> l{ 1, 2, 3, 4, 5, 6 };
+      // exercise
+      size_t num = l.remove_if([](int i) { return i % 2 == 0; });
+      // verify
+      assertUnit(num == 3);
+      assertUnit(holds(l, { 1, 3, 5 }));
+   }  // teardown
+
+   // runs of equal items shrink to their first
+   void test_unique()
+   {  // setup
+      custom::list<int> l{ 1, 1, 2, 3, 3, 3, 1, 4, 4 };
+      custom::list<int> near{ 1, 2, 4, 5, 9 };
+      // exercise
+      size_t num = l.unique();
+      size_t numNear = near.unique([](int a, int b) { return b - a == 1; });
+      // verify
+      assertUnit(num == 4);
+      assertUnit(holds(l, { 1, 2, 3, 1, 4 }));
+      assertUnit(numNear == 2);
+      assertUnit(holds(near, { 1, 4, 9 }));
+   }  // teardown
+
+   // a range goes and the item after it is returned
+   void test_erase_range()
+   {  // setup
+      custom::list<int> l{ 1, 2, 3, 4, 5 };
+      // exercise
+      auto it = l.erase(at(l, 1), at(l, 4));
+      // verify
+      assertUnit(*it == 5);
+      assertUnit(holds(l, { 1, 5 }));
+      it = l.erase(l.begin(), l.end());
+      assertUnit(it == l.end());
+      assertUnit(holds(l, { }));
+   }  // teardown
+
+   // moving nodes between lists never copies, moves or allocates
+   void test_relink_spy()
+   {  // setup
+      AllocCounts counts = {};
+      CountingAllocator<Spy> alloc(&counts);
+      custom::list<Spy, CountingAllocator<Spy> > a{alloc};
+      custom::list<Spy, CountingAllocator<Spy> > b{alloc};
+      for (int i = 0; i < 8; i++)
+      {
+         a.push_back(Spy(2 * i));
+         b.push_back(Spy(2 * i + 1));
+      }
+      Spy::reset();
+      int allocated = counts.numAllocate;
+      // exercise
+      a.merge(b);
+      b.splice(b.end(), a, a.begin(), at(a, 4));
+      b.splice(b.begin(), a, a.begin());
+      a.splice(a.end(), b);
+      a.reverse();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(counts.numAllocate == allocated);
+      assertUnit(a.size() == 16);
+      assertUnit(b.empty());
+   }  // teardown
+
+   /***************************************
+    * EMPLACE
+    ***************************************/
+
+   // one constructor call per item, built in the node
+   void test_emplaceBack_spy()
+   {  // setup
+      custom::list<Spy> l;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 5; i++)
+         l.emplace_back(i);
+      Spy & last = l.emplace_back();
+      // verify
+      assertUnit(Spy::numNondefault() == 5);
+      assertUnit(Spy::numDefault() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(&last == &l.back());
+      assertUnit(l.size() == 6);
+   }  // teardown
+
+   // the same at the front
+   void test_emplaceFront_spy()
+   {  // setup
+      custom::list<Spy> l;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 3; i++)
+         l.emplace_front(i);
+      // verify
+      assertUnit(Spy::numNondefault() == 3);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(l.front() == Spy(2));
+      assertUnit(l.back() == Spy(0));
+   }  // teardown
+
+   // an item built in the middle is linked before it
+   void test_emplace_middle()
+   {  // setup
+      custom::list<int> l{ 1, 2, 4 };
+      // exercise
+      auto it = l.emplace(at(l, 2), 3);
+      auto itEnd = l.emplace(l.end(), 5);
+      // verify
+      assertUnit(*it == 3);
+      assertUnit(*itEnd == 5);
+      assertUnit(holds(l, { 1, 2, 3, 4, 5 }));
+   }  // teardown
+
+   // every argument goes to T's constructor
+   void test_emplace_args()
+   {  // setup
+      custom::list<Keyed> l;
+      // exercise
+      Keyed & k = l.emplace_back(Keyed{ 4, 2 });
+      // verify
+      assertUnit(k.key == 4);
+      assertUnit(k.tag == 2);
+      custom::list<custom::list<int> > lists;
+      lists.emplace_back((size_t)3, 7);
+      assertUnit(lists.front().size() == 3);
+      assertUnit(lists.front().back() == 7);
+   }  // teardown
+
+   // a node whose item fails to construct goes straight back
+   void test_emplace_throws()
+   {  // setup
+      AllocCounts counts = {};
+      custom::list<Thrower, CountingAllocator<Thrower> > l{CountingAllocator<Thrower>(&counts)};
+      l.emplace_back(false);
+      Thrower bad(true);
+      bool threw = false;
+      // exercise
+      try
+      {
+         l.emplace_front(bad);
+      }
+      catch (const std::runtime_error &)
+      {
+         threw = true;
+      }
+      // verify
+      assertUnit(threw);
+      assertUnit(l.size() == 1);
+      assertUnit(counts.live() == 1);
+      assertUnit(l.pHead == l.pTail);
+   }  // teardown
+
+   // a counted list default-builds each item in its node
+   void test_construct_countDefault()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::list<Spy> l(4);
+      // verify
+      assertUnit(l.size() == 4);
+      assertUnit(Spy::numDefault() == 4);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+   }  // teardown
+
+   // a counted list copies the value once per item
+   void test_construct_countValue()
+   {  // setup
+      Spy s(9);
+      Spy::reset();
+      // exercise
+      custom::list<Spy> l(4, s);
+      // verify
+      assertUnit(l.size() == 4);
+      assertUnit(Spy::numCopy() == 4);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(l.back() == s);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,338 @@
+/***********************************************************************
+ * Header:
+ *    TEST NODE POOL
+ * Summary:
+ *    Unit tests for node_pool and pool_allocator
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <cstdint>               // for uintptr_t
+#include <set>                   // for std::set
+#include "nodePool.h"            // class under test
+#include "../Array/unitTest.h"   // unit test baseclass
+#include "../Array/spy.h"        // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST NODE POOL
+ * Unit tests for the node pool and its allocator
+ ***********************************************/
+class TestNodePool : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Pool
+      test_pool_configure();
+      test_pool_aligned();
+      test_pool_recycle();
+      test_pool_slabFull();
+      test_pool_keepsSlabs();
+      test_pool_shrinkEmpty();
+      test_pool_shrinkPartial();
+
+      // Allocator
+      test_alloc_rebindShares();
+      test_alloc_array();
+      test_list_reuses();
+      test_list_shrink();
+      test_list_spy();
+      test_list_sharedPool();
+      test_list_moveAssign();
+      test_list_useAfterMove();
+
+      report("NodePool");
+   }
+
+   // twenty-four bytes, aligned to eight, like a list<int> node
+   struct Block
+   {
+      void * p[3];
+   };
+
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // the slab is a power of two big enough for the blocks asked for
+   void test_pool_configure()
+   {  // setup
+      custom::node_pool pool(100);
+      // exercise
+      bool serves = pool.serves(sizeof(Block), alignof(Block));
+      // verify
+      assertUnit(serves);
+      assertUnit(pool.blockSize == 24);
+      assertUnit((pool.slabBytes & (pool.slabBytes - 1)) == 0);
+      assertUnit(pool.blocks_per_slab() >= 100);
+      assertUnit(pool.blockOffset + pool.blocks_per_slab() * pool.blockSize <= pool.slabBytes);
+      assertUnit(!pool.serves(sizeof(Block) + 8, alignof(Block)));
+      assertUnit(pool.slab_count() == 0);
+   }  // teardown
+
+   // slabs are aligned to their size, blocks to theirs
+   void test_pool_aligned()
+   {  // setup
+      custom::node_pool pool(10);
+      pool.serves(sizeof(Block), alignof(Block));
+      // exercise
+      void * p = pool.allocate();
+      // verify
+      uintptr_t slab = reinterpret_cast<uintptr_t>(pool.pSlabs);
+      assertUnit(slab % pool.slabBytes == 0);
+      assertUnit(reinterpret_cast<uintptr_t>(p) % alignof(Block) == 0);
+      assertUnit(pool.slabOf(p) == pool.pSlabs);
+      pool.deallocate(p);
+   }  // teardown
+
+   // the block given back last is the next one handed out
+   void test_pool_recycle()
+   {  // setup
+      custom::node_pool pool(10);
+      pool.serves(sizeof(Block), alignof(Block));
+      void * a = pool.allocate();
+      void * b = pool.allocate();
+      // exercise
+      pool.deallocate(a);
+      void * c = pool.allocate();
+      // verify
+      assertUnit(c == a);
+      assertUnit(b != a);
+      assertUnit(pool.in_use() == 2);
+      pool.deallocate(b);
+      pool.deallocate(c);
+   }  // teardown
+
+   // a second slab only when the first is used up
+   void test_pool_slabFull()
+   {  // setup
+      custom::node_pool pool(4);
+      pool.serves(sizeof(Block), alignof(Block));
+      size_t perSlab = pool.blocks_per_slab();
+      std::set<void *> blocks;
+      // exercise
+      for (size_t i = 0; i < perSlab; i++)
+         blocks.insert(pool.allocate());
+      size_t slabsWhenFull = pool.slab_count();
+      blocks.insert(pool.allocate());
+      // verify
+      assertUnit(slabsWhenFull == 1);
+      assertUnit(pool.slab_count() == 2);
+      assertUnit(blocks.size() == perSlab + 1);
+      for (void * p : blocks)
+         pool.deallocate(p);
+   }  // teardown
+
+   // giving every block back keeps the slabs for next time
+   void test_pool_keepsSlabs()
+   {  // setup
+      custom::node_pool pool(4);
+      pool.serves(sizeof(Block), alignof(Block));
+      void * blocks[20];
+      for (int i = 0; i < 20; i++)
+         blocks[i] = pool.allocate();
+      size_t slabs = pool.slab_count();
+      // exercise
+      for (int i = 0; i < 20; i++)
+         pool.deallocate(blocks[i]);
+      for (int i = 0; i < 20; i++)
+         blocks[i] = pool.allocate();
+      // verify
+      assertUnit(pool.slab_count() == slabs);
+      assertUnit(pool.in_use() == 20);
+      for (int i = 0; i < 20; i++)
+         pool.deallocate(blocks[i]);
+   }  // teardown
+
+   // every slab goes back when nothing is in use
+   void test_pool_shrinkEmpty()
+   {  // setup
+      custom::node_pool pool(4);
+      pool.serves(sizeof(Block), alignof(Block));
+      void * blocks[20];
+      for (int i = 0; i < 20; i++)
+         blocks[i] = pool.allocate();
+      for (int i = 0; i < 20; i++)
+         pool.deallocate(blocks[i]);
+      size_t slabs = pool.slab_count();
+      // exercise
+      size_t freed = pool.shrink();
+      // verify
+      assertUnit(freed == slabs);
+      assertUnit(pool.slab_count() == 0);
+      assertUnit(pool.pFree == nullptr);
+      void * p = pool.allocate();
+      assertUnit(pool.slab_count() == 1);
+      pool.deallocate(p);
+   }  // teardown
+
+   // a slab with a block still in use stays, with its free blocks
+   void test_pool_shrinkPartial()
+   {  // setup
+      custom::node_pool pool(4);
+      pool.serves(sizeof(Block), alignof(Block));
+      size_t perSlab = pool.blocks_per_slab();
+      void * blocks[40];
+      size_t num = perSlab * 3 < 40 ? perSlab * 3 : 40;
+      for (size_t i = 0; i < num; i++)
+         blocks[i] = pool.allocate();
+      void * kept = blocks[0];
+      for (size_t i = 1; i < num; i++)
+         pool.deallocate(blocks[i]);
+      // exercise
+      pool.shrink();
+      // verify
+      assertUnit(pool.slab_count() == 1);
+      assertUnit(pool.in_use() == 1);
+      bool sameSlab = true;
+      for (size_t i = 1; i < perSlab; i++)
+         sameSlab = sameSlab && pool.slabOf(pool.allocate()) == pool.slabOf(kept);
+      assertUnit(sameSlab);
+      assertUnit(pool.slab_count() == 1);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // a rebound copy hands out blocks from the same pool
+   void test_alloc_rebindShares()
+   {  // setup
+      custom::pool_allocator<int> a(16);
+      // exercise
+      custom::pool_allocator<Block> b(a);
+      Block * p = b.allocate(1);
+      // verify
+      assertUnit(a == b);
+      assertUnit(a.pool().in_use() == 1);
+      assertUnit(custom::pool_allocator<int>(16) != a);
+      b.deallocate(p, 1);
+      assertUnit(a.pool().in_use() == 0);
+   }  // teardown
+
+   // more than one object at a time does not come from the pool
+   void test_alloc_array()
+   {  // setup
+      custom::pool_allocator<Block> a(16);
+      // exercise
+      Block * p = a.allocate(5);
+      // verify
+      assertUnit(a.pool().in_use() == 0);
+      assertUnit(a.pool().slab_count() == 0);
+      a.deallocate(p, 5);
+   }  // teardown
+
+   // a list that churns reuses its nodes instead of asking for more
+   void test_list_reuses()
+   {  // setup
+      custom::pooled_list<int> l{custom::pool_allocator<int>(64)};
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      size_t slabs = l.get_allocator().pool().slab_count();
+      // exercise
+      for (int round = 0; round < 50; round++)
+      {
+         l.erase(l.begin());
+         l.push_back(round);
+      }
+      // verify
+      assertUnit(l.size() == 100);
+      assertUnit(l.get_allocator().pool().in_use() == 100);
+      assertUnit(l.get_allocator().pool().slab_count() == slabs);
+   }  // teardown
+
+   // after clear the slabs stay until the list asks to shrink
+   void test_list_shrink()
+   {  // setup
+      custom::pooled_list<int> l{custom::pool_allocator<int>(16)};
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      l.clear();
+      size_t slabs = l.get_allocator().pool().slab_count();
+      // exercise
+      size_t freed = l.get_allocator().shrink();
+      // verify
+      assertUnit(slabs > 1);
+      assertUnit(freed == slabs);
+      assertUnit(l.get_allocator().pool().slab_count() == 0);
+      l.push_back(7);
+      assertUnit(l.front() == 7);
+   }  // teardown
+
+   // values are still built and destroyed exactly once
+   void test_list_spy()
+   {  // setup
+      Spy::reset();
+      // exercise
+      {
+         custom::pooled_list<Spy> l;
+         for (int i = 0; i < 10; i++)
+            l.push_back(Spy(i));
+         l.pop_front();
+      }
+      // verify
+      assertUnit(Spy::numNondefault() == 10);
+      assertUnit(Spy::numCopyMove() == 10);
+      assertUnit(Spy::numDestructor() == 20);
+   }  // teardown
+
+   // two lists can draw from one pool
+   void test_list_sharedPool()
+   {  // setup
+      custom::pool_allocator<int> shared(32);
+      custom::pooled_list<int> a(shared);
+      custom::pooled_list<int> b(shared);
+      // exercise
+      a.push_back(1);
+      b.push_back(2);
+      b.push_back(3);
+      // verify
+      assertUnit(shared.pool().in_use() == 3);
+      assertUnit(shared.pool().slab_count() == 1);
+   }  // teardown
+
+   // the pool follows its nodes on a move
+   void test_list_moveAssign()
+   {  // setup
+      custom::pooled_list<int> a;
+      custom::pooled_list<int> b;
+      b.push_back(1);
+      b.push_back(2);
+      custom::pool_allocator<int> poolB = b.get_allocator();
+      // exercise
+      a = std::move(b);
+      // verify
+      assertUnit(a.get_allocator() == poolB);
+      assertUnit(poolB.pool().in_use() == 2);
+      a.pop_back();
+      assertUnit(poolB.pool().in_use() == 1);
+   }  // teardown
+
+   // a list moved from, either way, can still be filled
+   void test_list_useAfterMove()
+   {  // setup
+      custom::pooled_list<int> a;
+      a.push_back(1);
+      a.push_back(2);
+      // exercise
+      custom::pooled_list<int> b(std::move(a));
+      a.push_back(3);
+      custom::pooled_list<int> c;
+      c = std::move(b);
+      b.push_back(4);
+      // verify
+      assertUnit(a.size() == 1 && a.front() == 3);
+      assertUnit(b.size() == 1 && b.front() == 4);
+      assertUnit(c.size() == 2 && c.back() == 2);
+      assertUnit(a.get_allocator() == c.get_allocator());
+      assertUnit(c.get_allocator().pool().in_use() == 4);
+   }  // teardown
+};
+
+#endif // DEBUG
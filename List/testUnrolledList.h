@@ -0,0 +1,476 @@
+/***********************************************************************
+ * Header:
+ *    TEST UNROLLED LIST
+ * Summary:
+ *    Unit tests for unrolled_list
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include <list>                  // for std::list to compare against
+#include <string>                // for std::string
+#include "unrolledList.h"        // class under test
+#include "../Array/unitTest.h"   // unit test baseclass
+#include "../Array/spy.h"        // spy is a mock class to monitor the class under test
+
+/***********************************************
+ * TEST UNROLLED LIST
+ * Unit tests for the unrolled list
+ ***********************************************/
+class TestUnrolledList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_fill();
+      test_construct_initializerList();
+      test_construct_copy();
+      test_construct_move();
+
+      // Assign
+      test_assign_copy();
+      test_assign_move();
+      test_swap();
+
+      // Insert
+      test_pushBack_fillsNodes();
+      test_pushFront_fillsNodes();
+      test_insert_middle();
+      test_insert_split();
+      test_insert_splitSmallest();
+      test_insert_splitAliased();
+      test_insert_end();
+
+      // Remove
+      test_erase_middle();
+      test_erase_emptiesNode();
+      test_erase_merge();
+      test_pop();
+      test_clear();
+
+      // Iterate
+      test_iterate_backward();
+      test_random_matchesList();
+      test_spy_balanced();
+
+      report("UnrolledList");
+   }
+
+   typedef custom::unrolled_list<int, 4> List4;
+
+   // every element, front to back
+   template <class L>
+   static std::list<int> contents(L & l)
+   {
+      std::list<int> out;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         out.push_back(*it);
+      return out;
+   }
+
+   // the node count, and whether every node holds 1..K elements
+   template <class L>
+   static size_t nodes(L & l, bool & valid)
+   {
+      size_t num = 0;
+      size_t total = 0;
+      valid = true;
+      for (auto p = l.pHead; p; p = p->pNext)
+      {
+         num++;
+         total += p->count;
+         valid = valid && p->count > 0 && p->count <= 4;
+         valid = valid && (p->pNext ? p->pNext->pPrev == p : l.pTail == p);
+      }
+      valid = valid && total == l.size();
+      return num;
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty list has no nodes
+   void test_construct_default()
+   {  // setup
+      // exercise
+      List4 l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // count copies of a value
+   void test_construct_fill()
+   {  // setup
+      // exercise
+      List4 l(10, 7);
+      // verify
+      bool valid;
+      assertUnit(l.size() == 10);
+      assertUnit(nodes(l, valid) == 3);
+      assertUnit(valid);
+      assertUnit(contents(l) == std::list<int>(10, 7));
+   }  // teardown
+
+   // values in order from a brace list
+   void test_construct_initializerList()
+   {  // setup
+      // exercise
+      List4 l{ 1, 2, 3, 4, 5 };
+      // verify
+      assertUnit(contents(l) == std::list<int>({ 1, 2, 3, 4, 5 }));
+      assertUnit(l.front() == 1);
+      assertUnit(l.back() == 5);
+   }  // teardown
+
+   // a copy has its own nodes
+   void test_construct_copy()
+   {  // setup
+      List4 a{ 1, 2, 3, 4, 5, 6 };
+      // exercise
+      List4 b(a);
+      // verify
+      assertUnit(contents(b) == contents(a));
+      assertUnit(b.pHead != a.pHead);
+      b.front() = 99;
+      assertUnit(a.front() == 1);
+   }  // teardown
+
+   // a move takes the nodes
+   void test_construct_move()
+   {  // setup
+      List4 a{ 1, 2, 3, 4, 5, 6 };
+      auto pHead = a.pHead;
+      // exercise
+      List4 b(std::move(a));
+      // verify
+      assertUnit(b.pHead == pHead);
+      assertUnit(b.size() == 6);
+      assertUnit(a.empty());
+      assertUnit(a.pHead == nullptr);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // copy replaces what was there
+   void test_assign_copy()
+   {  // setup
+      List4 a{ 1, 2, 3 };
+      List4 b{ 9, 9, 9, 9, 9, 9, 9 };
+      // exercise
+      b = a;
+      // verify
+      assertUnit(contents(b) == std::list<int>({ 1, 2, 3 }));
+      assertUnit(contents(a) == std::list<int>({ 1, 2, 3 }));
+   }  // teardown
+
+   // move replaces what was there and empties the source
+   void test_assign_move()
+   {  // setup
+      List4 a{ 1, 2, 3, 4, 5 };
+      List4 b{ 9, 9 };
+      // exercise
+      b = std::move(a);
+      // verify
+      assertUnit(contents(b) == std::list<int>({ 1, 2, 3, 4, 5 }));
+      assertUnit(a.empty());
+   }  // teardown
+
+   // swap exchanges the nodes
+   void test_swap()
+   {  // setup
+      List4 a{ 1, 2 };
+      List4 b{ 3, 4, 5, 6, 7 };
+      // exercise
+      swap(a, b);
+      // verify
+      assertUnit(contents(a) == std::list<int>({ 3, 4, 5, 6, 7 }));
+      assertUnit(contents(b) == std::list<int>({ 1, 2 }));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // pushing on the back fills every node before starting another
+   void test_pushBack_fillsNodes()
+   {  // setup
+      List4 l;
+      // exercise
+      for (int i = 0; i < 9; i++)
+         l.push_back(i);
+      // verify
+      bool valid;
+      assertUnit(nodes(l, valid) == 3);
+      assertUnit(valid);
+      assertUnit(l.pHead->count == 4);
+      assertUnit(l.pTail->count == 1);
+      assertUnit(l.back() == 8);
+   }  // teardown
+
+   // pushing on the front fills every node too
+   void test_pushFront_fillsNodes()
+   {  // setup
+      List4 l;
+      // exercise
+      for (int i = 0; i < 9; i++)
+         l.push_front(i);
+      // verify
+      bool valid;
+      assertUnit(nodes(l, valid) == 3);
+      assertUnit(valid);
+      assertUnit(l.pHead->count == 1);
+      assertUnit(contents(l) == std::list<int>({ 8, 7, 6, 5, 4, 3, 2, 1, 0 }));
+   }  // teardown
+
+   // inserting in a node with room slides the rest back
+   void test_insert_middle()
+   {  // setup
+      List4 l{ 1, 2, 4 };
+      auto it = l.begin();
+      ++it;
+      ++it;
+      // exercise
+      auto itNew = l.insert(it, 3);
+      // verify
+      assertUnit(*itNew == 3);
+      assertUnit(l.pHead == l.pTail);
+      assertUnit(contents(l) == std::list<int>({ 1, 2, 3, 4 }));
+   }  // teardown
+
+   // inserting in a full node splits it in half
+   void test_insert_split()
+   {  // setup
+      List4 l{ 10, 20, 30, 40 };
+      auto it = l.begin();
+      for (int i = 0; i < 3; i++)
+         ++it;
+      // exercise
+      auto itNew = l.insert(it, 35);
+      // verify
+      bool valid;
+      assertUnit(*itNew == 35);
+      assertUnit(nodes(l, valid) == 2);
+      assertUnit(valid);
+      assertUnit(l.pHead->count == 2);
+      assertUnit(l.pTail->count == 3);
+      assertUnit(contents(l) == std::list<int>({ 10, 20, 30, 35, 40 }));
+      ++itNew;
+      assertUnit(*itNew == 40);
+   }  // teardown
+
+   // with two to a node a split leaves one on each side
+   void test_insert_splitSmallest()
+   {  // setup
+      custom::unrolled_list<int, 2> l;
+      l.push_back(1);
+      l.push_back(2);
+      // exercise
+      auto it = l.insert(l.begin(), 0);
+      l.insert(l.end(), 3);
+      // verify
+      bool valid;
+      assertUnit(*it == 0);
+      assertUnit(nodes(l, valid) == 2);
+      assertUnit(valid);
+      assertUnit(contents(l) == std::list<int>({ 0, 1, 2, 3 }));
+   }  // teardown
+
+   // the value can be an element of the node being split
+   void test_insert_splitAliased()
+   {  // setup
+      custom::unrolled_list<std::string, 4> l{ "alpha", "beta", "gamma", "delta" };
+      // exercise
+      l.insert(l.begin(), l.back());
+      l.insert(l.rbegin(), l.front());
+      // verify
+      std::list<std::string> expect{ "delta", "alpha", "beta", "gamma", "delta", "delta" };
+      std::list<std::string> actual;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         actual.push_back(*it);
+      assertUnit(actual == expect);
+   }  // teardown
+
+   // inserting before end() appends
+   void test_insert_end()
+   {  // setup
+      List4 l{ 1, 2, 3, 4 };
+      // exercise
+      auto it = l.insert(l.end(), 5);
+      // verify
+      assertUnit(*it == 5);
+      assertUnit(l.back() == 5);
+      assertUnit(l.size() == 5);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erasing returns the element that followed
+   void test_erase_middle()
+   {  // setup
+      List4 l{ 1, 2, 3, 4, 5, 6, 7, 8 };
+      auto it = l.begin();
+      ++it;
+      // exercise
+      it = l.erase(it);
+      // verify
+      assertUnit(*it == 3);
+      assertUnit(contents(l) == std::list<int>({ 1, 3, 4, 5, 6, 7, 8 }));
+   }  // teardown
+
+   // erasing the last element of a node frees it
+   void test_erase_emptiesNode()
+   {  // setup
+      List4 l{ 1, 2, 3, 4, 5 };
+      auto it = l.begin();
+      for (int i = 0; i < 4; i++)
+         ++it;
+      // exercise
+      it = l.erase(it);
+      // verify
+      bool valid;
+      assertUnit(it == l.end());
+      assertUnit(nodes(l, valid) == 1);
+      assertUnit(valid);
+      assertUnit(l.back() == 4);
+   }  // teardown
+
+   // a node less than half full takes in the next when both fit
+   void test_erase_merge()
+   {  // setup
+      List4 l{ 1, 2, 3, 4, 5, 6 };
+      auto it = l.begin();
+      it = l.erase(it);
+      it = l.erase(it);
+      // exercise
+      it = l.erase(it);
+      // verify
+      bool valid;
+      assertUnit(*it == 4);
+      assertUnit(nodes(l, valid) == 1);
+      assertUnit(valid);
+      assertUnit(contents(l) == std::list<int>({ 4, 5, 6 }));
+   }  // teardown
+
+   // pop from both ends until nothing is left
+   void test_pop()
+   {  // setup
+      List4 l{ 1, 2, 3, 4, 5, 6 };
+      // exercise
+      l.pop_back();
+      l.pop_front();
+      // verify
+      assertUnit(contents(l) == std::list<int>({ 2, 3, 4, 5 }));
+      while (!l.empty())
+         l.pop_back();
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+      l.pop_front();
+      l.pop_back();
+      assertUnit(l.size() == 0);
+   }  // teardown
+
+   // clear frees every node and the list can be used again
+   void test_clear()
+   {  // setup
+      List4 l{ 1, 2, 3, 4, 5, 6 };
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr);
+      l.push_back(1);
+      assertUnit(l.front() == 1);
+   }  // teardown
+
+   /***************************************
+    * ITERATE
+    ***************************************/
+
+   // walking back from rbegin() crosses nodes
+   void test_iterate_backward()
+   {  // setup
+      List4 l{ 1, 2, 3, 4, 5, 6, 7 };
+      std::list<int> backward;
+      // exercise
+      for (auto it = l.rbegin(); it != l.end(); --it)
+         backward.push_back(*it);
+      // verify
+      assertUnit(backward == std::list<int>({ 7, 6, 5, 4, 3, 2, 1 }));
+   }  // teardown
+
+   // a long run of mixed inserts and erases agrees with std::list
+   void test_random_matchesList()
+   {  // setup
+      List4 l;
+      std::list<int> expect;
+      unsigned seed = 12345;
+      bool valid = true;
+      // exercise
+      for (int i = 0; i < 2000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         size_t where = l.size() ? (seed >> 8) % (l.size() + 1) : 0;
+         auto it = l.begin();
+         auto itExpect = expect.begin();
+         for (size_t j = 0; j < where; j++, ++it, ++itExpect)
+            ;
+         if ((seed >> 4) % 3)
+         {
+            auto itNew = l.insert(it, i);
+            expect.insert(itExpect, i);
+            valid = valid && *itNew == i;
+         }
+         else if (it != l.end())
+         {
+            it = l.erase(it);
+            itExpect = expect.erase(itExpect);
+            valid = valid && (it == l.end() ? itExpect == expect.end() : *it == *itExpect);
+         }
+         bool nodesValid;
+         nodes(l, nodesValid);
+         valid = valid && nodesValid;
+      }
+      // verify
+      assertUnit(valid);
+      assertUnit(contents(l) == expect);
+   }  // teardown
+
+   // values are built and destroyed in pairs across splits and merges
+   void test_spy_balanced()
+   {  // setup
+      Spy::reset();
+      // exercise
+      {
+         custom::unrolled_list<Spy, 4> l;
+         for (int i = 0; i < 20; i++)
+            l.push_back(Spy(i));
+         auto it = l.begin();
+         ++it;
+         l.insert(it, Spy(100));
+         for (int i = 0; i < 10; i++)
+            l.erase(l.begin());
+      }
+      // verify
+      assertUnit(Spy::numNondefault() == 21);
+      assertUnit(Spy::numDestructor() == Spy::numNondefault() + Spy::numCopyMove());
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,720 @@
+/***********************************************************************
+ * Header:
+ *    UNROLLED LIST
+ * Summary:
+ *    A linked list whose nodes hold several elements each, so a walk
+ *    through it reads mostly contiguous memory
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        unrolled_list           : the same interface as custom::list
+ *        unrolled_list::iterator : a node and a position in it
+ *
+ *    Each node keeps up to K elements packed at the front of an
+ *    inline buffer. Inserting into a full node splits it in half;
+ *    erasing from a node that drops below half full pulls in the
+ *    next node when both fit in one. Pushing at either end fills
+ *    nodes completely.
+ *
+ *    Iterators: insert and erase leave iterators into other nodes
+ *    alone. Iterators into the node they change, and into the node
+ *    a split or merge moves elements to, must be refreshed from the
+ *    iterator insert and erase return.
+ * Author
+ *    Ashlee Hart
+ ************************************************************************/
+
+#pragma once
+#include <cstddef>     // for size_t
+#include <initializer_list> // for std::initializer_list
+#include <memory>      // for std::allocator and std::allocator_traits
+#include <new>         // for std::launder
+#include <type_traits> // for std::enable_if and std::is_integral
+#include <utility>     // for std::move, std::forward and std::swap
+
+class TestUnrolledList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * UNROLLED DEFAULT CAPACITY
+ * How many T's fit in a node of about four cache
+ * lines, counting its links, but never fewer than 4
+ **************************************************/
+template <typename T>
+constexpr int unrolled_default_capacity()
+{
+   return (256 - 3 * sizeof(void *)) / sizeof(T) < 4 ?
+          4 : (int)((256 - 3 * sizeof(void *)) / sizeof(T));
+}
+
+/**************************************************
+ * UNROLLED LIST
+ * Just like custom::list, with up to K elements
+ * in every node
+ **************************************************/
+template <typename T, int K = unrolled_default_capacity<T>(), typename A = std::allocator<T>>
+class unrolled_list
+{
+   friend class ::TestUnrolledList; // give unit tests access to the privates
+
+   // a split must leave both halves with at least one element
+   static_assert(K >= 2, "unrolled_list nodes must hold at least two elements");
+public:
+
+   //
+   // Construct
+   //
+
+   unrolled_list(const A& a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr) { }
+   unrolled_list(const unrolled_list & rhs) :
+      alloc(NodeTraits::select_on_container_copy_construction(rhs.alloc)),
+      numElements(0), pHead(nullptr), pTail(nullptr)
+   {
+      append(rhs);
+   }
+   unrolled_list(unrolled_list && rhs) :
+      alloc(std::move(rhs.alloc)), numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
+   {
+      rhs.pHead = rhs.pTail = nullptr;
+      rhs.numElements = 0;
+   }
+   unrolled_list(size_t num, const T & t, const A& a = A()) :
+      alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+   {
+      for (size_t i = 0; i < num; i++)
+         push_back(t);
+   }
+   unrolled_list(size_t num, const A& a = A()) :
+      alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+   {
+      for (size_t i = 0; i < num; i++)
+         push_back(T());
+   }
+   unrolled_list(const std::initializer_list<T>& il, const A& a = A()) :
+      alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+   {
+      for (const T & item : il)
+         push_back(item);
+   }
+   template <class Iterator, class = typename std::enable_if<!std::is_integral<Iterator>::value>::type>
+   unrolled_list(Iterator first, Iterator last, const A& a = A()) :
+      alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+   {
+      for (Iterator it = first; it != last; ++it)
+         push_back(*it);
+   }
+
+   ~unrolled_list()
+   {
+      clear();
+   }
+
+   //
+   // Assign
+   //
+
+   unrolled_list & operator = (const unrolled_list &  rhs);
+   unrolled_list & operator = (unrolled_list && rhs);
+   unrolled_list & operator = (const std::initializer_list<T>& il)
+   {
+      clear();
+      for (const T & item : il)
+         push_back(item);
+      return *this;
+   }
+
+   void swap(unrolled_list & rhs)
+   {
+      std::swap(pHead, rhs.pHead);
+      std::swap(pTail, rhs.pTail);
+      std::swap(numElements, rhs.numElements);
+      if (NodeTraits::propagate_on_container_swap::value)
+      {
+         using std::swap;
+         swap(alloc, rhs.alloc);
+      }
+   }
+
+   A get_allocator() const { return A(alloc); }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin()  { return iterator(pHead, 0); }
+   iterator rbegin() { return pTail ? iterator(pTail, pTail->count - 1) : end(); }
+   iterator end()    { return iterator(nullptr, 0); }
+
+   //
+   // Access
+   //
+
+   T & front();
+   T & back();
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  data) { pushFront(data);            }
+   void push_front(      T && data) { pushFront(std::move(data)); }
+   void push_back (const T &  data) { pushBack(data);             }
+   void push_back (      T && data) { pushBack(std::move(data));  }
+   iterator insert(iterator it, const T &  data) { return insertBefore(it, data);            }
+   iterator insert(iterator it,       T && data) { return insertBefore(it, std::move(data)); }
+
+   //
+   // Remove
+   //
+
+   void pop_back();
+   void pop_front()
+   {
+      if (pHead)
+         erase(begin());
+   }
+   void clear();
+   iterator erase(const iterator & it);
+
+   //
+   // Status
+   //
+
+   bool empty()  const { return size() == 0; }
+   size_t size() const { return numElements; }
+
+private:
+   // nested node class
+   class Node;
+
+   // the allocator A, rebound to hand out whole nodes instead of T's
+   typedef typename std::allocator_traits<A>::template rebind_alloc<Node> NodeAlloc;
+   typedef std::allocator_traits<NodeAlloc> NodeTraits;
+
+   // allocate an empty node, or deallocate one whose elements are gone
+   Node * createNode();
+   void destroyNode(Node * pNode);
+
+   // put pNode into the chain after pPrev, or at the head if pPrev is null
+   void linkAfter(Node * pPrev, Node * pNode);
+   void unlink(Node * pNode);
+
+   // move the back half of a full node into a new node after it
+   Node * split(Node * pNode);
+
+   // move every element of the next node into this one, then free it
+   void merge(Node * pNode);
+
+   // put a new element at index in a node that has room
+   template <class U>
+   void insertAt(Node * pNode, size_t index, U && data);
+
+   template <class U> void pushBack(U && data);
+   template <class U> void pushFront(U && data);
+   template <class U> iterator insertBefore(iterator it, U && data);
+
+   // copy every element of rhs onto the end
+   void append(const unrolled_list & rhs);
+
+   // member variables
+   NodeAlloc alloc;    // every node is allocated and built through this
+   size_t numElements; // the elements in all the nodes
+   Node * pHead;       // pointer to the first node
+   Node * pTail;       // pointer to the last node
+};
+
+/*************************************************
+ * NODE
+ * Up to K elements, built in place at the front
+ * of an uninitialized buffer, and the links
+ *************************************************/
+template <typename T, int K, typename A>
+class unrolled_list<T, K, A>::Node
+{
+public:
+   Node() : pNext(nullptr), pPrev(nullptr), count(0) { }
+
+   // element i, which must have been constructed
+   T & at(size_t i)
+   {
+      return *std::launder(reinterpret_cast<T *>(storage) + i);
+   }
+
+   // room for element i, which must not have been constructed
+   void * slot(size_t i)
+   {
+      return reinterpret_cast<T *>(storage) + i;
+   }
+
+   Node * pNext;       // pointer to next node
+   Node * pPrev;       // pointer to previous node
+   size_t count;       // elements 0 .. count-1 are constructed
+   alignas(T) unsigned char storage[K * sizeof(T)];
+};
+
+/*************************************************
+ * UNROLLED LIST ITERATOR
+ * A node and the index of an element in it. The
+ * end iterator has no node.
+ ************************************************/
+template <typename T, int K, typename A>
+class unrolled_list<T, K, A>::iterator
+{
+   friend class ::TestUnrolledList; // give unit tests access to the privates
+   template <typename TT, int KK, typename AA>
+   friend class custom::unrolled_list;
+public:
+   iterator() : p(nullptr), index(0) { }
+   iterator(Node * p, size_t index) : p(p), index(index) { }
+
+   bool operator == (const iterator & rhs) const { return p == rhs.p && index == rhs.index; }
+   bool operator != (const iterator & rhs) const { return !(*this == rhs); }
+
+   T & operator * () { return p->at(index); }
+
+   // Prefix increment: the next element, in this node while it lasts
+   iterator & operator ++ ()
+   {
+      if (p && ++index == p->count)
+      {
+         p = p->pNext;
+         index = 0;
+      }
+      return *this;
+   }
+   iterator operator ++ (int)
+   {
+      iterator temp = *this;
+      ++*this;
+      return temp;
+   }
+
+   // Prefix decrement: like list, decrementing end() stays at end()
+   iterator & operator -- ()
+   {
+      if (p)
+      {
+         if (index)
+            index--;
+         else
+         {
+            p = p->pPrev;
+            index = p ? p->count - 1 : 0;
+         }
+      }
+      return *this;
+   }
+   iterator operator -- (int)
+   {
+      iterator temp = *this;
+      --*this;
+      return temp;
+   }
+
+private:
+   Node * p;       // the node holding the element
+   size_t index;   // where the element is in the node
+};
+
+/**********************************************
+ * UNROLLED LIST :: CREATE NODE
+ * Get room for one node from the allocator and
+ * build it there, empty and unlinked
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+typename unrolled_list <T, K, A> :: Node * unrolled_list <T, K, A> :: createNode()
+{
+   Node * pNode = NodeTraits::allocate(alloc, 1);
+   NodeTraits::construct(alloc, pNode);
+   return pNode;
+}
+
+/**********************************************
+ * UNROLLED LIST :: DESTROY NODE
+ * Give an empty node back to the allocator
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+void unrolled_list <T, K, A> :: destroyNode(Node * pNode)
+{
+   NodeTraits::destroy(alloc, pNode);
+   NodeTraits::deallocate(alloc, pNode, 1);
+}
+
+/**********************************************
+ * UNROLLED LIST :: LINK AFTER
+ * Put pNode into the chain after pPrev
+ *     INPUT  : the node to follow, null for the head,
+ *              and the unlinked node
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+void unrolled_list <T, K, A> :: linkAfter(Node * pPrev, Node * pNode)
+{
+   Node * pNext = pPrev ? pPrev->pNext : pHead;
+   pNode->pPrev = pPrev;
+   pNode->pNext = pNext;
+   if (pPrev)
+      pPrev->pNext = pNode;
+   else
+      pHead = pNode;
+   if (pNext)
+      pNext->pPrev = pNode;
+   else
+      pTail = pNode;
+}
+
+/**********************************************
+ * UNROLLED LIST :: UNLINK
+ * Take pNode out of the chain
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+void unrolled_list <T, K, A> :: unlink(Node * pNode)
+{
+   if (pNode->pPrev)
+      pNode->pPrev->pNext = pNode->pNext;
+   else
+      pHead = pNode->pNext;
+   if (pNode->pNext)
+      pNode->pNext->pPrev = pNode->pPrev;
+   else
+      pTail = pNode->pPrev;
+}
+
+/**********************************************
+ * UNROLLED LIST :: SPLIT
+ * Move the back half of pNode into a new node
+ * linked right after it
+ *     INPUT  : a full node
+ *     OUTPUT : the new node
+ *     COST   : O(K)
+ *********************************************/
+template <typename T, int K, typename A>
+typename unrolled_list <T, K, A> :: Node * unrolled_list <T, K, A> :: split(Node * pNode)
+{
+   Node * pNew = createNode();
+   size_t keep = pNode->count - pNode->count / 2;
+   for (size_t i = keep; i < pNode->count; i++)
+   {
+      new (pNew->slot(pNew->count)) T(std::move(pNode->at(i)));
+      pNew->count++;
+      pNode->at(i).~T();
+   }
+   pNode->count = keep;
+   linkAfter(pNode, pNew);
+   return pNew;
+}
+
+/**********************************************
+ * UNROLLED LIST :: MERGE
+ * Move the elements of the next node onto the end
+ * of this one, then free the next node
+ *     INPUT  : a node with room for all of the next
+ *     COST   : O(K)
+ *********************************************/
+template <typename T, int K, typename A>
+void unrolled_list <T, K, A> :: merge(Node * pNode)
+{
+   Node * pNext = pNode->pNext;
+   for (size_t i = 0; i < pNext->count; i++)
+   {
+      new (pNode->slot(pNode->count)) T(std::move(pNext->at(i)));
+      pNode->count++;
+      pNext->at(i).~T();
+   }
+   pNext->count = 0;
+   unlink(pNext);
+   destroyNode(pNext);
+}
+
+/**********************************************
+ * UNROLLED LIST :: INSERT AT
+ * Open a gap at index by sliding the elements after
+ * it back one place, then fill it
+ *     INPUT  : a node with room, where, and the value
+ *     COST   : O(K)
+ *********************************************/
+template <typename T, int K, typename A>
+template <class U>
+void unrolled_list <T, K, A> :: insertAt(Node * pNode, size_t index, U && data)
+{
+   if (index == pNode->count)
+      new (pNode->slot(index)) T(std::forward<U>(data));
+   else
+   {
+      // data may be one of the elements about to slide
+      T temp(std::forward<U>(data));
+      new (pNode->slot(pNode->count)) T(std::move(pNode->at(pNode->count - 1)));
+      for (size_t i = pNode->count - 1; i > index; i--)
+         pNode->at(i) = std::move(pNode->at(i - 1));
+      pNode->at(index) = std::move(temp);
+   }
+   pNode->count++;
+   numElements++;
+}
+
+/*********************************************
+ * UNROLLED LIST :: PUSH BACK
+ * Add an element to the end, starting a new node
+ * only when the last one is full
+ *    INPUT  : data to be added to the list
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+template <class U>
+void unrolled_list <T, K, A> :: pushBack(U && data)
+{
+   if (!pTail || pTail->count == (size_t)K)
+      linkAfter(pTail, createNode());
+   insertAt(pTail, pTail->count, std::forward<U>(data));
+}
+
+/*********************************************
+ * UNROLLED LIST :: PUSH FRONT
+ * Add an element to the front, starting a new node
+ * only when the first one is full
+ *    INPUT  : data to be added to the list
+ *    COST   : O(K)
+ *********************************************/
+template <typename T, int K, typename A>
+template <class U>
+void unrolled_list <T, K, A> :: pushFront(U && data)
+{
+   if (!pHead || pHead->count == (size_t)K)
+      linkAfter(nullptr, createNode());
+   insertAt(pHead, 0, std::forward<U>(data));
+}
+
+/******************************************
+ * UNROLLED LIST :: INSERT
+ * Add an element before it, splitting its node
+ * first if the node is full
+ *     INPUT  : where, and the data to be added
+ *     OUTPUT : iterator to the new element
+ *     COST   : O(K)
+ ******************************************/
+template <typename T, int K, typename A>
+template <class U>
+typename unrolled_list <T, K, A> :: iterator
+unrolled_list <T, K, A> :: insertBefore(iterator it, U && data)
+{
+   if (it.p == nullptr)
+   {
+      pushBack(std::forward<U>(data));
+      return iterator(pTail, pTail->count - 1);
+   }
+
+   Node * pNode = it.p;
+   size_t index = it.index;
+   if (pNode->count == (size_t)K)
+   {
+      // data may be one of the elements the split moves away
+      T temp(std::forward<U>(data));
+      Node * pNew = split(pNode);
+      if (index > pNode->count)
+      {
+         index -= pNode->count;
+         pNode = pNew;
+      }
+      insertAt(pNode, index, std::move(temp));
+   }
+   else
+      insertAt(pNode, index, std::forward<U>(data));
+   return iterator(pNode, index);
+}
+
+/******************************************
+ * UNROLLED LIST :: ERASE
+ * Remove one element by sliding the ones after it
+ * forward. An empty node is freed; a node less than
+ * half full takes in the next node if they both fit.
+ *     INPUT  : an iterator to the element to remove
+ *     OUTPUT : iterator to the element after it
+ *     COST   : O(K)
+ ******************************************/
+template <typename T, int K, typename A>
+typename unrolled_list <T, K, A> :: iterator
+unrolled_list <T, K, A> :: erase(const iterator & it)
+{
+   Node * pNode = it.p;
+   if (pNode == nullptr)
+      return end();
+   size_t index = it.index;
+
+   for (size_t i = index; i + 1 < pNode->count; i++)
+      pNode->at(i) = std::move(pNode->at(i + 1));
+   pNode->at(pNode->count - 1).~T();
+   pNode->count--;
+   numElements--;
+
+   if (pNode->count == 0)
+   {
+      Node * pNext = pNode->pNext;
+      unlink(pNode);
+      destroyNode(pNode);
+      return iterator(pNext, 0);
+   }
+
+   if (pNode->count < (size_t)K / 2 && pNode->pNext &&
+       pNode->count + pNode->pNext->count <= (size_t)K)
+      merge(pNode);
+
+   if (index < pNode->count)
+      return iterator(pNode, index);
+   return iterator(pNode->pNext, 0);
+}
+
+/*********************************************
+ * UNROLLED LIST :: POP BACK
+ * Remove the last element, and its node if that
+ * leaves the node empty
+ *    COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+void unrolled_list <T, K, A> :: pop_back()
+{
+   if (pTail)
+   {
+      Node * pNode = pTail;
+      pNode->at(pNode->count - 1).~T();
+      pNode->count--;
+      numElements--;
+      if (pNode->count == 0)
+      {
+         unlink(pNode);
+         destroyNode(pNode);
+      }
+   }
+}
+
+/**********************************************
+ * UNROLLED LIST :: CLEAR
+ * Destroy every element and free every node
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, int K, typename A>
+void unrolled_list <T, K, A> :: clear()
+{
+   while (pHead)
+   {
+      Node * pNext = pHead->pNext;
+      for (size_t i = 0; i < pHead->count; i++)
+         pHead->at(i).~T();
+      pHead->count = 0;
+      destroyNode(pHead);
+      pHead = pNext;
+   }
+   pTail = nullptr;
+   numElements = 0;
+}
+
+/**********************************************
+ * UNROLLED LIST :: APPEND
+ * Copy the elements of rhs onto the end
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, int K, typename A>
+void unrolled_list <T, K, A> :: append(const unrolled_list & rhs)
+{
+   for (Node * p = rhs.pHead; p; p = p->pNext)
+      for (size_t i = 0; i < p->count; i++)
+         push_back(p->at(i));
+}
+
+/**********************************************
+ * UNROLLED LIST :: assignment operator
+ * Copy one list onto another, taking the RHS's
+ * allocator first if it propagates
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, int K, typename A>
+unrolled_list <T, K, A> & unrolled_list <T, K, A> :: operator = (const unrolled_list & rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      if (NodeTraits::propagate_on_container_copy_assignment::value)
+         alloc = rhs.alloc;
+      append(rhs);
+   }
+   return *this;
+}
+
+/**********************************************
+ * UNROLLED LIST :: assignment operator - MOVE
+ * Take the RHS's nodes if our allocator can free
+ * them; otherwise move the values one at a time
+ *     COST   : O(n) with respect to the size of the LHS
+ *********************************************/
+template <typename T, int K, typename A>
+unrolled_list <T, K, A> & unrolled_list <T, K, A> :: operator = (unrolled_list && rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      if (NodeTraits::propagate_on_container_move_assignment::value || alloc == rhs.alloc)
+      {
+         if (NodeTraits::propagate_on_container_move_assignment::value)
+            alloc = std::move(rhs.alloc);
+         std::swap(pHead, rhs.pHead);
+         std::swap(pTail, rhs.pTail);
+         std::swap(numElements, rhs.numElements);
+      }
+      else
+      {
+         for (Node * p = rhs.pHead; p; p = p->pNext)
+            for (size_t i = 0; i < p->count; i++)
+               push_back(std::move(p->at(i)));
+         rhs.clear();
+      }
+   }
+   return *this;
+}
+
+/*********************************************
+ * UNROLLED LIST :: FRONT
+ * The first element
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+T & unrolled_list <T, K, A> :: front()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+   return pHead->at(0);
+}
+
+/*********************************************
+ * UNROLLED LIST :: BACK
+ * The last element
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, int K, typename A>
+T & unrolled_list <T, K, A> :: back()
+{
+   if (empty())
+      throw "ERROR: unable to access data from an empty list";
+   return pTail->at(pTail->count - 1);
+}
+
+/**********************************************
+ * SWAP
+ * Exchange the contents of two unrolled lists
+ *********************************************/
+template <typename T, int K, typename A>
+void swap(unrolled_list <T, K, A> & lhs, unrolled_list <T, K, A> & rhs)
+{
+   lhs.swap(rhs);
+}
+
+}; // namespace custom
@@ -41,8 +41,8 @@ public:
    //
    
    stack()                       : container() {}
-   stack(const stack <T> &  rhs) : container(rhs.container) {}
-   stack(      stack <T> && rhs) : container(std::move(rhs.container)) {}
+   stack(const stack     &  rhs) : container(rhs.container) {}
+   stack(      stack     && rhs) : container(std::move(rhs.container)) {}
    stack(const Container &  rhs) : container(rhs) {}
    stack(      Container && rhs) : container(std::move(rhs)) {}
    ~stack()                      {                      }
@@ -50,17 +50,17 @@ public:
    //
    // Assign
    //
-   stack <T> & operator = (const stack <T> & rhs)
+   stack & operator = (const stack & rhs)
    {
       container = rhs.container;
       return *this;
    }
-   stack <T>& operator = (stack <T> && rhs)
+   stack & operator = (stack && rhs)
    {
       container = std::move(rhs.container);
       return *this;
    }
-   void swap(stack <T>& rhs)
+   void swap(stack & rhs)
    {
       container.swap(rhs.container);
    }